@@ -41,6 +41,9 @@ namespace Ark::internal::Builtins
         Value sort_(std::vector<Value>& n, VM* vm);        // list:sort, 1 argument
         Value fill(std::vector<Value>& n, VM* vm);         // list:fill, 2 arguments
         Value setListAt(std::vector<Value>& n, VM* vm);    // list:setAt, 3 arguments
+        Value parallelMap(std::vector<Value>& n, VM* vm);     // list:parallelMap, 2 arguments
+        Value parallelFilter(std::vector<Value>& n, VM* vm);  // list:parallelFilter, 2 arguments
+        Value parallelReduce(std::vector<Value>& n, VM* vm);  // list:parallelReduce, 2 arguments
     }
 
     namespace IO
@@ -113,6 +116,9 @@ namespace Ark::internal::Builtins
     {
         Value async(std::vector<Value>& n, VM* vm);  // async, 1+ arguments
         Value await(std::vector<Value>& n, VM* vm);  // await, 1 argument
+        Value spawn(std::vector<Value>& n, VM* vm);  // spawn, 1+ arguments
+        Value yield(std::vector<Value>& n, VM* vm);  // yield, 0 argument
+        Value join(std::vector<Value>& n, VM* vm);   // join, 1 argument
     }
 }
 
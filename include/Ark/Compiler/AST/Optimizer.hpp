@@ -12,8 +12,9 @@
 #ifndef COMPILER_AST_OPTIMIZER_HPP
 #define COMPILER_AST_OPTIMIZER_HPP
 
-#include <functional>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <cinttypes>
 
@@ -52,8 +53,27 @@ namespace Ark::internal
         [[nodiscard]] const Node& ast() const noexcept override;
 
     private:
+        using Constants = std::unordered_map<std::string, Node>;
+
+        /**
+         * @brief What can change while a loop runs
+         *
+         */
+        struct Loop
+        {
+            std::unordered_set<std::string> bound_symbols;  ///< Symbols defined, modified or deleted in the loop
+            bool runs_user_code = false;                    ///< True if the loop calls functions, which could modify other variables
+            bool is_local = false;                          ///< True if the loop is in a function, where the variables are loaded by name
+        };
+
         Node m_ast;
-        std::unordered_map<std::string, unsigned> m_sym_appearances;
+        std::unordered_map<std::string, unsigned> m_sym_appearances;  ///< Number of times each symbol is read
+        std::unordered_map<std::string, unsigned> m_sym_bindings;     ///< Number of times each symbol is defined, modified or deleted
+        Constants m_global_constants;                                 ///< Global constants defined by a `let` seen so far, and their value
+        std::unordered_set<std::string> m_sym_mutations;              ///< Symbols modified by a set or an in place list operation, or deleted
+        Constants m_inline_functions;                                 ///< Global functions defined by a `let` seen so far, small enough to be inlined
+        std::vector<std::string> m_inlining;                          ///< Functions being inlined, to stop on recursive calls
+        std::size_t m_hoisted_count = 0;                              ///< Number of loop invariant expressions moved out of their loop
 
         /**
          * @brief Generate a fancy error message
@@ -64,25 +84,177 @@ namespace Ark::internal
         [[noreturn]] static void throwOptimizerError(const std::string& message, const Node& node);
 
         /**
-         * @brief Iterate over the AST and remove unused top level functions and constants
+         * @brief Remove the dead code from the AST, until there is nothing more to remove
          *
          */
         void removeUnused();
 
         /**
-         * @brief Run a given functor on the global scope symbols
+         * @brief Count the reads of each symbol in the AST, recursively
+         * @details The symbols defined by a let or a mut, and the arguments of the functions, are not counted.
+         *
+         * @param node
+         */
+        void countOccurences(const Node& node);
+
+        /**
+         * @brief Remove the unreachable branches, the unused pure expressions and the unused local bindings, recursively
+         * @details The global bindings are kept, as they can be used by name from the host program.
+         *
+         * @param node
+         * @param is_result_unused true if the value computed by the node is dropped, as the compiler would see it
+         * @param is_local true if the node is inside a function
+         * @return true if some code was removed
+         */
+        bool removeDeadCode(Node& node, bool is_result_unused, bool is_local);
+
+        /**
+         * @brief Check if the value of a condition is known at compile time
+         *
+         * @param node condition of an if or a while
+         * @return std::optional<bool> the truthiness of the condition, std::nullopt if it is only known at runtime
+         */
+        [[nodiscard]] static std::optional<bool> constantCondition(const Node& node);
+
+        /**
+         * @brief Check if an expression can be removed without changing the behavior of the program
+         *
+         * @param node
+         * @return true if computing the node has no side effect and can not fail
+         */
+        [[nodiscard]] static bool isPure(const Node& node);
+
+        /**
+         * @brief Count the definitions (let, mut, function arguments), modifications (set, in place list
+         *        operations) and deletions of each symbol in the AST, recursively
+         *
+         * @param node
+         */
+        void countBindings(const Node& node);
+
+        /**
+         * @brief Fold the constant expressions of a block, and propagate the constants it defines to the next expressions
+         * @details Constants defined at the top level can be used in any function defined after them, while the constants
+         *          of a function are only propagated in its body, and not in the nested functions.
+         *
+         * @param block list of expressions run one after another
+         * @param locals constants of the function the block is in, nullptr for the top level
+         */
+        void foldBlock(Node& block, Constants* locals);
+
+        /**
+         * @brief Replace the known constants by their value in an expression and fold its operators calls on literals
+         *
+         * @param node
+         * @param locals constants of the function the expression is in, nullptr for the top level
+         */
+        void foldExpression(Node& node, const Constants* locals);
+
+        /**
+         * @brief Try to compute the result of an operator call at compile time
+         * @details Only the operators without side effects, called on numbers or strings literals, are computed. A call
+         *          which would fail at runtime is left as is, so that the error is still reported.
+         *
+         * @param node operator call, its arguments have already been folded
+         * @return std::optional<Node> the literal result, std::nullopt if it can not be computed
+         */
+        [[nodiscard]] static std::optional<Node> evaluateOperator(const Node& node);
+
+        /**
+         * @brief Check if a function can be inlined at its call sites
+         * @details The function must not capture variables and must have a small body, made of calls and conditions only.
+         *          The symbols it uses which aren't its arguments are looked up by name from the scope of the caller,
+         *          as they would be by the function at runtime. It can not call itself, nor use the in place list
+         *          operations, which would modify the variables given by the caller instead of the arguments.
+         *
+         * @param name name of the function
+         * @param function the function node, (fun (args) body)
+         * @return true if the function can be inlined
+         */
+        [[nodiscard]] bool isInlinable(const std::string& name, const Node& function) const;
+
+        /**
+         * @brief Check if the arguments of a function are read outside of it, by the functions it calls
+         * @details Must be called before the function is modified, as it compares the reads of the arguments in the
+         *          function with the ones counted in the whole AST.
+         *
+         * @param function the function node, (fun (args) body)
+         * @return true if an argument is read elsewhere, or if the node isn't a function
+         */
+        bool areArgumentsReadElsewhere(const Node& function);
+
+        /**
+         * @brief Check if a node can be part of the body of an inlined function, and count its nodes
+         *
+         * @param node
+         * @param name name of the function, to detect recursive calls
+         * @param arguments names of the arguments of the function
+         * @param size number of nodes found so far
+         * @return true if the node can be inlined
+         */
+        bool isInlinableBody(const Node& node, const std::string& name, const std::vector<Node>& arguments, std::size_t& size) const;
+
+        /**
+         * @brief Replace a call to an inlinable function by the body of the function, with its arguments replaced by their values
+         * @details The values given to the function must be literals or symbols, so that they can be read more than once, and
+         *          the symbols must not be modified during the call.
+         *
+         * @param call
+         * @return std::optional<Node> the inlined body, std::nullopt if the call can not be inlined
+         */
+        [[nodiscard]] std::optional<Node> inlineCall(const Node& call) const;
+
+        /**
+         * @brief Move the expressions computing the same value at each iteration of the while loops before them, recursively
+         * @details The inner loops are handled first, so that their invariants can be moved out of the outer loops as well.
+         *
+         * @param node
+         * @param is_local true if the node is inside a function
+         */
+        void hoistLoopInvariants(Node& node, bool is_local);
+
+        /**
+         * @brief Store the invariant expressions of a while loop in variables defined before it
+         * @details The expressions of the condition are computed before the loop. The ones of the body are computed
+         *          only if the condition is true the first time, as the loop is put in an if with the same condition,
+         *          which is only done if the condition has no side effects.
+         *
+         * @param loop (while condition body) node
+         * @param is_local true if the loop is inside a function
+         * @param before definitions of the variables holding the invariants of the condition
+         */
+        void hoistFromLoop(Node& loop, bool is_local, std::vector<Node>& before);
+
+        /**
+         * @brief Replace the invariant expressions of a loop by variables, in the order in which they are computed
+         * @details The search stops at the first node which may not be computed on each iteration (a branch, a short
+         *          circuit), which may have side effects (a function call, a binding) or which may throw (most operators,
+         *          a field): an invariant computed before it could fail earlier than the original code. The invariants
+         *          cheaper to compute than to load from a variable are kept.
+         *
+         * @param node
+         * @param loop
+         * @param hoisted definitions of the variables created, (let name expression)
+         * @return true if the search can go on with the next node computed
+         */
+        bool collectInvariants(Node& node, const Loop& loop, std::vector<Node>& hoisted);
+
+        /**
+         * @brief Check if an expression computes the same value at each iteration of a loop
          *
          * @param node
-         * @param func
+         * @param loop
+         * @return true if the expression is made of literals, symbols and fields not modified in the loop, and operators
          */
-        void runOnGlobalScopeVars(Node& node, const std::function<void(Node&, Node&, std::size_t)>& func);
+        [[nodiscard]] bool isLoopInvariant(const Node& node, const Loop& loop) const;
 
         /**
-         * @brief Count the occurrences of each symbol in the AST, recursively
+         * @brief Collect the symbols defined, modified or deleted in a node, recursively
          *
          * @param node
+         * @param symbols
          */
-        void countOccurences(Node& node);
+        static void collectBoundSymbols(const Node& node, std::unordered_set<std::string>& symbols);
     };
 }
 
@@ -16,6 +16,7 @@
 #include <string>
 #include <cinttypes>
 #include <optional>
+#include <unordered_set>
 
 #include <Ark/Platform.hpp>
 #include <Ark/Compiler/Instructions.hpp>
@@ -77,11 +78,25 @@ namespace Ark::internal
             bool is_temp;
         };
 
+        /**
+         * @brief Variables of a function which can be accessed by slot instead of by name
+         * @details Arguments are stored in order at the beginning of the function frame,
+         *          and captured variables are in the closure scope, in order of capture.
+         *
+         */
+        struct FunctionLocals
+        {
+            std::vector<std::string> arguments;
+            std::vector<std::string> captures;
+        };
+
         // tables: symbols, values, plugins and codes
         std::vector<std::string> m_symbols;
         std::vector<ValTableElem> m_values;
         std::vector<IR::Block> m_code_pages;
         std::vector<IR::Block> m_temp_pages;  ///< we need temporary code pages for some compilations passes
+        std::vector<FunctionLocals> m_locals;  ///< locals of the functions being compiled, the innermost one being the last
+        std::unordered_set<std::string> m_frame_bound_symbols;  ///< names of the arguments, captures and variables defined inside functions
 
         unsigned m_debug;  ///< the debug level of the compiler
 
@@ -130,6 +145,50 @@ namespace Ark::internal
          */
         static bool nodeProducesOutput(const Node& node);
 
+        /**
+         * @brief Check if a variable is defined (let, mut) or deleted in a function body, shadowing a captured variable
+         *
+         * @param name name of the variable
+         * @param body function body
+         * @param in_nested_function true when looking inside a function declared in the body
+         * @return true if the captured variable can not be loaded from the closure scope
+         */
+        static bool isCaptureShadowed(const std::string& name, const Node& body, bool in_nested_function = false);
+
+        /**
+         * @brief Register the names that can be bound in a function frame: arguments, captures, and variables defined in a function
+         *
+         * @param node node to visit
+         * @param in_function true when visiting the body of a function
+         */
+        void findFrameBoundSymbols(const Node& node, bool in_function);
+
+        /**
+         * @brief Check if a variable used in the function being compiled can only be found in the global scope
+         * @details With dynamic scoping, a name is looked up in every frame. If it is never bound in a function
+         *          frame, the lookup can go straight to the global scope
+         *
+         * @param name name of the variable
+         * @return true if the variable can be loaded with GLOBAL_LOAD and changed with GLOBAL_STORE
+         */
+        [[nodiscard]] bool isGlobalOnly(const std::string& name) const noexcept;
+
+        /**
+         * @brief Find the slot of an argument of the function being compiled
+         *
+         * @param name name of the variable
+         * @return std::optional<uint16_t> slot in the function frame
+         */
+        [[nodiscard]] std::optional<uint16_t> findLocalSlot(const std::string& name) const noexcept;
+
+        /**
+         * @brief Find the slot of a captured variable of the function being compiled
+         *
+         * @param name name of the variable
+         * @return std::optional<uint16_t> slot in the closure scope
+         */
+        [[nodiscard]] std::optional<uint16_t> findUpvalueSlot(const std::string& name) const noexcept;
+
         /**
          * @brief Check if a given instruction is unary (takes only one argument)
          *
@@ -96,7 +96,26 @@ namespace Ark::internal
         STORE_HEAD = 0x39,
         SET_VAL_TAIL = 0x3a,
         SET_VAL_HEAD = 0x3b,
-        CALL_BUILTIN = 0x3c
+        CALL_BUILTIN = 0x3c,
+
+        LOAD_LOCAL = 0x3d,
+        STORE_LOCAL = 0x3e,
+        LOAD_UPVALUE = 0x3f,
+        GLOBAL_LOAD = 0x40,
+        GLOBAL_STORE = 0x41,
+
+        TAIL_CALL = 0x42,
+        GET_FIELD_CALL = 0x43,
+
+        LOAD_SYMBOL_LOAD_CONST_ADD = 0x44,
+        LOAD_SYMBOL_GET_FIELD = 0x45,
+
+        JUMP_IF_LT = 0x46,
+        JUMP_IF_LE = 0x47,
+        JUMP_IF_GT = 0x48,
+        JUMP_IF_GE = 0x49,
+        JUMP_IF_EQ = 0x4a,
+        JUMP_IF_NEQ = 0x4b
     };
 
     constexpr std::array InstructionNames = {
@@ -162,7 +181,27 @@ namespace Ark::internal
         "STORE_HEAD",
         "SET_VAL_TAIL",
         "SET_VAL_HEAD",
-        "CALL_BUILTIN"
+        "CALL_BUILTIN",
+        // locals
+        "LOAD_LOCAL",
+        "STORE_LOCAL",
+        "LOAD_UPVALUE",
+        // globals
+        "GLOBAL_LOAD",
+        "GLOBAL_STORE",
+        // calls
+        "TAIL_CALL",
+        "GET_FIELD_CALL",
+        // super instructions on symbols
+        "LOAD_SYMBOL_LOAD_CONST_ADD",
+        "LOAD_SYMBOL_GET_FIELD",
+        // compare and jump
+        "JUMP_IF_LT",
+        "JUMP_IF_LE",
+        "JUMP_IF_GT",
+        "JUMP_IF_GE",
+        "JUMP_IF_EQ",
+        "JUMP_IF_NEQ"
     };
 }
 
@@ -0,0 +1,120 @@
+/**
+ * @file ControlFlowGraph.hpp
+ * @author Alexandre Plateau (lexplt.dev@gmail.com)
+ * @brief Basic blocks of an IR block, linked by their jumps, to run optimization passes on the control flow
+ * @version 0.1
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ARK_COMPILER_INTERMEDIATEREPRESENTATION_CONTROLFLOWGRAPH_HPP
+#define ARK_COMPILER_INTERMEDIATEREPRESENTATION_CONTROLFLOWGRAPH_HPP
+
+#include <cinttypes>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <Ark/Platform.hpp>
+#include <Ark/Compiler/IntermediateRepresentation/Entity.hpp>
+
+namespace Ark::internal::IR
+{
+    /**
+     * @brief A sequence of entities always executed from the first one to the last one
+     *
+     */
+    struct BasicBlock
+    {
+        Block labels;                            ///< Labels pointing at the start of the block
+        Block entities;                          ///< Entities of the block, only the last one can be a jump
+        std::vector<std::size_t> predecessors;   ///< Blocks which can run right before this one
+        std::vector<std::size_t> successors;     ///< Blocks which can run right after this one
+        bool is_loop_header = false;             ///< Targeted by a jump coming from the block itself or a block after it in the loop
+        std::set<uint16_t> live_in;              ///< Local slots read before being written, in the block or one of its successors
+        std::set<uint16_t> live_out;             ///< Local slots which can be read by the successors
+    };
+
+    /**
+     * @brief Control flow graph of a page, built from its IR and lowered back to IR once optimized
+     *
+     */
+    class ARK_API ControlFlowGraph final
+    {
+    public:
+        /**
+         * @brief Split a block of IR in basic blocks, starting at each label and ending after each jump
+         *
+         * @param block
+         */
+        explicit ControlFlowGraph(const Block& block);
+
+        /**
+         * @brief Concatenate the basic blocks in their order, with their labels
+         *
+         * @return Block
+         */
+        [[nodiscard]] Block lower() const;
+
+        /**
+         * @brief Shorten the jumps going to another jump, to a return or to the next block, and invert the
+         * conditional jumps skipping an unconditional one
+         *
+         * @return std::size_t number of jumps modified
+         */
+        std::size_t threadJumps();
+
+        /**
+         * @brief Remove the blocks which can not be reached from the first one
+         *
+         * @return std::size_t number of blocks removed
+         */
+        std::size_t removeUnreachableBlocks();
+
+        /**
+         * @brief Mark the headers of the loops, targeted by a back edge
+         *
+         * @return std::size_t number of loops found
+         */
+        std::size_t detectLoops();
+
+        /**
+         * @brief Compute the local slots alive at the start and at the end of each block
+         * @details A STORE creates the slot of a new local variable without any index, thus only STORE_LOCAL
+         *          is considered to write a slot. The result is an over approximation of the live slots.
+         */
+        void computeLiveness();
+
+        [[nodiscard]] inline const std::vector<BasicBlock>& blocks() const noexcept { return m_blocks; }
+
+    private:
+        std::vector<BasicBlock> m_blocks;
+        std::unordered_map<label_t, std::size_t> m_label_to_block;
+
+        /**
+         * @brief Compute the predecessors and successors of each block
+         *
+         */
+        void computeEdges();
+
+        /**
+         * @brief Find the block a label points to
+         *
+         * @param label
+         * @return std::size_t index of the block, or the number of blocks if the label is unknown
+         */
+        [[nodiscard]] std::size_t blockOf(label_t label) const;
+
+        /**
+         * @brief Get the first label of a block targeted by a jump
+         *
+         * @param index
+         * @return const Entity&
+         */
+        [[nodiscard]] const Entity& labelOf(std::size_t index) const;
+    };
+}
+
+#endif  // ARK_COMPILER_INTERMEDIATEREPRESENTATION_CONTROLFLOWGRAPH_HPP
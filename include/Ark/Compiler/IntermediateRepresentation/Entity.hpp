@@ -26,6 +26,7 @@ namespace Ark::internal::IR
         Goto,
         GotoIfTrue,
         GotoIfFalse,
+        GotoWithInst,
         Opcode,
         Opcode2Args
     };
@@ -50,6 +51,9 @@ namespace Ark::internal::IR
 
         static Entity GotoIf(const Entity& label, bool cond);
 
+        /// A jump made by a given instruction, which takes the address of the label as argument
+        static Entity GotoWithInst(const Entity& label, Instruction inst);
+
         [[nodiscard]] Word bytecode() const;
 
         [[nodiscard]] inline label_t label() const { return m_label; }
@@ -2,7 +2,7 @@
  * @file IROptimizer.hpp
  * @author Alexandre Plateau (lexplt.dev@gmail.com)
  * @brief Optimize IR based on IR entity grouped by 2 (or more)
- * @version 0.2
+ * @version 0.3
  * @date 2024-10-11
  *
  * @copyright Copyright (c) 2024
@@ -16,7 +16,9 @@
 #include <Ark/Compiler/ValTableElem.hpp>
 #include <Ark/Compiler/IntermediateRepresentation/Entity.hpp>
 
-#include <optional>
+#include <functional>
+#include <span>
+#include <vector>
 
 namespace Ark::internal
 {
@@ -47,13 +49,39 @@ namespace Ark::internal
         [[nodiscard]] const std::vector<IR::Block>& intermediateRepresentation() const noexcept;
 
     private:
+        using Entities = std::span<const IR::Entity>;
+
+        /**
+         * @brief A peephole rule, replacing a sequence of instructions by a single entity
+         *
+         */
+        struct Rule
+        {
+            std::vector<Instruction> pattern;                                       ///< Instructions of the entities to replace, in order
+            std::function<bool(const IROptimizer&, Entities)> condition = nullptr;  ///< Optional, checked on the entities matching the pattern
+            std::function<IR::Entity(Entities)> replacement;                        ///< Create the entity replacing the ones matching the pattern
+        };
+
         Logger m_logger;
         std::vector<IR::Block> m_ir;
         std::vector<std::string> m_symbols;
         std::vector<ValTableElem> m_values;
 
-        [[nodiscard]] std::optional<IR::Entity> compactEntities(const IR::Entity& first, const IR::Entity& second);
-        [[nodiscard]] std::optional<IR::Entity> compactEntities(const IR::Entity& first, const IR::Entity& second, const IR::Entity& third);
+        /**
+         * @brief The peephole rules, by decreasing priority
+         *
+         * @return const std::vector<Rule>&
+         */
+        [[nodiscard]] static const std::vector<Rule>& rules();
+
+        /**
+         * @brief Replace all the sequences of entities matching a rule in a block, from left to right
+         *
+         * @param rule
+         * @param block
+         * @return true if the block was modified
+         */
+        bool applyRule(const Rule& rule, IR::Block& block) const;
 
         [[nodiscard]] bool isNumber(uint16_t id, double expected_number) const;
     };
@@ -0,0 +1,117 @@
+/**
+ * @file Coroutine.hpp
+ * @author Alexandre Plateau (lexplt.dev@gmail.com)
+ * @brief Lightweight tasks running on their own execution context, scheduled on the VM workers
+ * @version 0.1
+ * @date 2024-06-28
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ARK_VM_COROUTINE_HPP
+#define ARK_VM_COROUTINE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include <Ark/VM/Value.hpp>
+#include <Ark/VM/ExecutionContext.hpp>
+#include <Ark/VM/Scheduler.hpp>
+
+namespace Ark::internal
+{
+    /**
+     * @brief A function running on its own execution context, which can be suspended without blocking a thread
+     * @details Each call to run executes the coroutine until it yields, waits for another coroutine, or returns.
+     *          A suspended coroutine only keeps its execution context: it is given back to the scheduler
+     *          when it yields, and by the coroutine it waits for when it finishes.
+     */
+    class Coroutine : public Task
+    {
+    public:
+        /**
+         * @brief Create a Coroutine, it has to be given to the VM scheduler to be started
+         * @param context a dedicated context for the coroutine to run on
+         * @param vm non owning pointer to the VM
+         * @param args list of (function, arguments...) to create the coroutine
+         */
+        Coroutine(ExecutionContext* context, VM* vm, std::vector<Value>& args);
+
+        /**
+         * @brief Run the coroutine on the current thread until it is suspended or finishes
+         *
+         * @return true if the coroutine was run by this call
+         */
+        bool run() override;
+
+        /**
+         * @brief Get the coroutine running on the current thread
+         *
+         * @return Coroutine* nullptr if the current thread isn't running a coroutine
+         */
+        static Coroutine* current() noexcept;
+
+        /**
+         * @brief Suspend the coroutine after the current instruction, and give it back to the scheduler
+         * @details Must be called from the coroutine itself
+         *
+         */
+        void yield() noexcept;
+
+        /**
+         * @brief Wait for the coroutine to finish and get its result
+         * @details From another coroutine, the current coroutine is suspended and this returns a placeholder,
+         *          replaced by the result when it is resumed. Otherwise, the current thread runs pending tasks
+         *          while waiting.
+         *
+         * @return Value the result of the function, which can be retrieved multiple times
+         */
+        Value join();
+
+    private:
+        enum class Status : uint8_t
+        {
+            Ready,    ///< Waiting for a thread to run it
+            Running,
+            Parked,   ///< Waiting for another coroutine to finish
+            Woken,    ///< The coroutine it waited for finished before it was parked
+            Finished
+        };
+
+        ExecutionContext* m_context;
+        VM* m_vm;
+        std::vector<Value> m_args;
+        std::size_t m_frames_count;  ///< Frame count of the context before calling the function
+        bool m_started;
+        Coroutine* m_joined;  ///< Coroutine this one is waiting for, nullptr if none
+        Value m_value;
+        std::exception_ptr m_exception;
+        std::atomic<Status> m_status;
+        std::mutex m_mutex;                  ///< Protects m_waiters, and the transition to Finished
+        std::vector<Coroutine*> m_waiters;  ///< Coroutines parked until this one finishes
+
+        /**
+         * @brief Start the function, or resume it where it was suspended
+         *
+         */
+        void resume();
+
+        /**
+         * @brief Get the result, release the context and wake up the waiting coroutines
+         *
+         */
+        void finish();
+
+        /**
+         * @brief Give the coroutine back to the scheduler after the coroutine it waited for finished
+         *
+         */
+        void wake();
+    };
+}
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * @file DecodedInstruction.hpp
+ * @author Alexandre Plateau (lexplt.dev@gmail.com)
+ * @brief Instruction decoded from the bytecode, as executed by the virtual machine
+ * @version 0.1
+ * @date 2024-06-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ARK_VM_DECODEDINSTRUCTION_HPP
+#define ARK_VM_DECODEDINSTRUCTION_HPP
+
+#include <cinttypes>
+#include <vector>
+
+namespace Ark::internal
+{
+    /**
+     * @brief An instruction and its arguments, decoded once when the bytecode is loaded
+     * @details Instructions are stored on 4 bytes in the bytecode: the opcode, a padding byte, and a 2 bytes argument.
+     *          Super instructions use the padding byte and the argument to store two 12 bits arguments.
+     *
+     */
+    struct DecodedInstruction
+    {
+        uint8_t inst;        ///< Opcode
+        uint16_t arg;        ///< Immediate argument
+        uint16_t primary;    ///< First argument of a super instruction
+        uint16_t secondary;  ///< Second argument of a super instruction
+    };
+
+    using DecodedPage = std::vector<DecodedInstruction>;
+
+    /**
+     * @brief A decoded instruction where the opcode was replaced by the address of its implementation in the VM
+     * @details Used by the VM when it can jump directly to the code of the next instruction (computed gotos)
+     *
+     */
+    struct ThreadedInstruction
+    {
+        const void* handler;  ///< Address of the code implementing the instruction, can be replaced while running by a version specialized for the types of its operands
+        uint16_t arg;         ///< Immediate argument
+        uint16_t primary;     ///< First argument of a super instruction
+        uint16_t secondary;   ///< Second argument of a super instruction
+    };
+
+    using ThreadedPage = std::vector<ThreadedInstruction>;
+}
+
+#endif
@@ -12,7 +12,7 @@
 #ifndef ARK_VM_EXECUTIONCONTEXT_HPP
 #define ARK_VM_EXECUTIONCONTEXT_HPP
 
-#include <array>
+#include <vector>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -32,20 +32,26 @@ namespace Ark::internal
         static inline unsigned Count = 0;
 
         const bool primary;  ///< Tells if the current ExecutionContext is the primary one or not
-        std::size_t ip {};   ///< Instruction pointer
+        std::size_t ip {};   ///< Instruction pointer, index of the next instruction in the current page
         std::size_t pp {};   ///< Page pointer
-        uint16_t sp {};      ///< Stack pointer
-        uint16_t fc {};      ///< Frame count
+        std::size_t sp {};   ///< Stack pointer
+        std::size_t fc {};   ///< Frame count
         uint16_t last_symbol;
+        bool yielded = false;  ///< Set when the coroutine running on this context is suspended, to stop running it after the current builtin call
 
-        std::array<Value, VMStackSize> stack {};
+        std::vector<Value> stack;                                       ///< Values stack, grown by the VM when it is full
         std::vector<std::shared_ptr<Scope>> stacked_closure_scopes {};  ///< Stack the closure scopes to keep the closure alive as long as we are calling them
         std::optional<Scope> saved_scope {};                            ///< Scope created by CAPTURE <x> instructions, used by the MAKE_CLOSURE instruction
         std::vector<Scope> locals {};
+        std::vector<Scope::Storage> free_scopes {};                     ///< Memory of the scopes of the frames which returned, reused by the next calls
+        std::vector<std::vector<Value>> free_args {};                   ///< Memory of the arguments of the builtins which returned, reused by the next builtin calls
+        std::shared_ptr<const ScopeSnapshot> globals_snapshot {};      ///< Global scope of the parent context when this context was created, its values are copied in locals[0] when first accessed
+        std::shared_ptr<const ScopeSnapshot> children_snapshot {};     ///< Last snapshot of locals[0], shared with the contexts created from this one
 
-        ExecutionContext() noexcept :
+        explicit ExecutionContext(const std::size_t stack_size) noexcept :
             primary(Count == 0),
-            last_symbol(std::numeric_limits<uint16_t>::max())
+            last_symbol(std::numeric_limits<uint16_t>::max()),
+            stack(stack_size)
         {
             Count++;
         }
@@ -2,7 +2,7 @@
  * @file Future.hpp
  * @author Alexandre Plateau (lexplt.dev@gmail.com)
  * @brief
- * @version 0.1
+ * @version 0.2
  * @date 2022-05-28
  *
  * @copyright Copyright (c) 2022-2024
@@ -12,19 +12,22 @@
 #ifndef ARK_VM_FUTURE_HPP
 #define ARK_VM_FUTURE_HPP
 
-#include <future>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <vector>
 
 #include <Ark/VM/Value.hpp>
 #include <Ark/VM/ExecutionContext.hpp>
+#include <Ark/VM/Scheduler.hpp>
 
 namespace Ark::internal
 {
-    class Future
+    class Future : public Task
     {
     public:
         /**
-         * @brief Create a Future and immediately start it through std::async
+         * @brief Create a Future, it has to be given to the VM scheduler to be started
          * @param context a dedicated context for the future to run on
          * @param vm non owning pointer to the VM
          * @param args list of (function, arguments...) to create the future
@@ -32,15 +35,33 @@ namespace Ark::internal
         Future(ExecutionContext* context, VM* vm, std::vector<Value>& args);
 
         /**
-         * @brief Await the future, blocking the thread it is ran on
+         * @brief Run the function of the future on the current thread, if no other thread has started it
+         *
+         * @return true if the function was run by this call
+         */
+        bool run() override;
+
+        /**
+         * @brief Await the future, running it or other pending futures on the current thread while it isn't finished
          * @return Value Nil if the future is invalid (has already been awaited), otherwise the value
          */
         Value resolve();
 
     private:
+        enum class Status : uint8_t
+        {
+            Pending,
+            Running,
+            Done,
+            Awaited
+        };
+
         ExecutionContext* m_context;
         VM* m_vm;
-        std::future<Value> m_value;  ///< The actual thread
+        std::vector<Value> m_args;
+        Value m_value;
+        std::exception_ptr m_exception;
+        std::atomic<Status> m_status;
     };
 }
 
@@ -0,0 +1,161 @@
+/**
+ * @file Jit.hpp
+ * @author Alexandre Plateau (lexplt.dev@gmail.com)
+ * @brief Copy-and-patch compiler of the hot loops to x86-64 machine code
+ * @version 0.1
+ * @date 2024-10-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ARK_VM_JIT_HPP
+#define ARK_VM_JIT_HPP
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <Ark/VM/DecodedInstruction.hpp>
+#include <Ark/VM/ExecutionContext.hpp>
+#include <Ark/VM/Value.hpp>
+
+namespace Ark::internal
+{
+    /**
+     * @brief State shared by the VM and the native code: read when entering it, written back when it returns to the interpreter
+     *
+     */
+    struct JitFrame
+    {
+        Value* top;                ///< First free value on the stack
+        uint16_t last_symbol;      ///< Last symbol loaded, for the error messages
+        std::size_t locals_count;  ///< Number of slots in the scope of the current function
+    };
+
+    /**
+     * @brief A variable used by the native code of a page, found by the VM each time it enters the native code
+     *
+     */
+    struct JitVariable
+    {
+        uint16_t id;   ///< Symbol id
+        bool global;   ///< Read or written by GLOBAL_LOAD and GLOBAL_STORE, found in the global scope only
+        bool written;  ///< Modified by the native code
+    };
+
+    /**
+     * @brief Machine code of a page, with one block of code per instruction
+     * @details Each block checks the types of its operands first, and gives the instruction back to the
+     *          interpreter when they aren't the expected ones. Unsupported instructions are blocks going
+     *          back to the interpreter, which runs them and everything after them.
+     */
+    class JitPage final
+    {
+    public:
+        /**
+         * @brief Native code of a page, entered at an instruction. Returns the index of the instruction where the interpreter resumes
+         *
+         */
+        using Function = uint32_t (*)(Value* stack, Value* top, Value* const* variables, void* locals, Value* stack_end, JitFrame* frame);
+
+        /**
+         * @brief Compile a page
+         *
+         * @param page instructions of the page
+         * @param constants constants of the program, referenced by the LOAD_CONST instructions
+         * @return std::unique_ptr<JitPage> nullptr if the memory for the code couldn't be allocated
+         */
+        static std::unique_ptr<JitPage> compile(const DecodedPage& page, std::vector<Value>& constants);
+
+        ~JitPage();
+
+        JitPage(const JitPage&) = delete;
+        JitPage& operator=(const JitPage&) = delete;
+
+        /**
+         * @brief Check if a loop closed by a jump can run in native code: every instruction between its start and the jump is supported
+         *
+         * @param jump index of the JUMP instruction going back to the start of the loop
+         */
+        [[nodiscard]] bool isNativeLoop(const std::size_t jump) const noexcept { return m_native_loops[jump]; }
+
+        /**
+         * @brief Get the native code starting at an instruction
+         *
+         * @param ip index of the instruction
+         */
+        [[nodiscard]] Function entry(std::size_t ip) const noexcept;
+
+        [[nodiscard]] const std::vector<JitVariable>& variables() const noexcept { return m_variables; }
+
+    private:
+        uint8_t* m_code;                    ///< Executable memory holding the code of the page
+        std::size_t m_size;                 ///< Size of the executable memory in bytes
+        std::vector<uint32_t> m_offsets;    ///< Offset of the code of each instruction
+        std::vector<bool> m_native_loops;   ///< For each backward JUMP, true if its loop is fully supported
+        std::vector<JitVariable> m_variables;  ///< Variables used by the code, in the order of the table given by the VM
+
+        JitPage() noexcept;
+    };
+
+    /**
+     * @brief Count the loops run by the interpreter in each page, and compile the pages where they are hot
+     * @details Only one execution context runs native code, so that the counters and the compiled pages
+     *          don't have to be shared between threads.
+     *
+     */
+    class Jit final
+    {
+    public:
+        /**
+         * @brief Create the JIT of an execution context
+         *
+         * @param context the only execution context allowed to run native code, it must outlive the JIT
+         */
+        explicit Jit(const ExecutionContext& context) noexcept;
+
+        /**
+         * @brief Check if the JIT was built in this version of ArkScript (option ARK_ENABLE_JIT, x86-64 Linux only)
+         *
+         */
+        [[nodiscard]] static bool isAvailable() noexcept;
+
+        /**
+         * @brief Check if an execution context can run native code
+         *
+         * @param context
+         */
+        [[nodiscard]] bool runsOn(const ExecutionContext& context) const noexcept { return &context == m_context; }
+
+        /**
+         * @brief Count a backward jump in a page, and compile the page when it reaches the threshold
+         *
+         * @param pages all the pages of the program
+         * @param pp index of the page
+         * @param constants constants of the program
+         * @return JitPage* nullptr while the page isn't compiled
+         */
+        JitPage* hotPage(const std::vector<DecodedPage>& pages, std::size_t pp, std::vector<Value>& constants);
+
+        /**
+         * @brief Forget the compiled pages, when the code changes
+         *
+         */
+        void reset() noexcept;
+
+    private:
+        struct PageState
+        {
+            uint32_t jumps = 0;             ///< Backward jumps run by the interpreter
+            bool compiled = false;          ///< Set once the page went through the compiler, even if it failed
+            std::unique_ptr<JitPage> code;  ///< Native code of the page
+        };
+
+        const ExecutionContext* m_context;
+        std::vector<PageState> m_pages;
+    };
+}
+
+#endif
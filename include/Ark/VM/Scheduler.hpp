@@ -0,0 +1,146 @@
+/**
+ * @file Scheduler.hpp
+ * @author Alexandre Plateau (lexplt.dev@gmail.com)
+ * @brief Work stealing scheduler running the futures and the coroutines
+ * @version 0.1
+ * @date 2024-06-24
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ARK_VM_SCHEDULER_HPP
+#define ARK_VM_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ark::internal
+{
+    /**
+     * @brief Work given to the scheduler: a future, or a slice of a coroutine
+     *
+     */
+    class Task
+    {
+    public:
+        virtual ~Task() = default;
+
+        /**
+         * @brief Run the task on the current thread
+         *
+         * @return true if the task was run by this call, false if it had already been started by another thread
+         */
+        virtual bool run() = 0;
+
+        /**
+         * @brief Get the task running on the current thread
+         *
+         * @return Task* nullptr if no task is running on the current thread
+         */
+        static Task* current() noexcept;
+
+    protected:
+        /**
+         * @brief Mark a task as running on the current thread until the end of the scope
+         * @details Tasks can run inside other tasks, when waiting for them
+         */
+        class RunningScope
+        {
+        public:
+            explicit RunningScope(Task* task) noexcept;
+            ~RunningScope();
+
+            RunningScope(const RunningScope&) = delete;
+            RunningScope& operator=(const RunningScope&) = delete;
+
+        private:
+            Task* m_previous;
+        };
+    };
+
+    /**
+     * @brief Pool of workers running the tasks
+     * @details Each worker has its own queue of tasks: it takes the last one it pushed, and when
+     *          its queue is empty it steals the oldest task of another worker. Threads waiting
+     *          for a task to finish help by running pending tasks.
+     */
+    class Scheduler
+    {
+    public:
+        /**
+         * @brief Create the scheduler and start its workers
+         *
+         * @param workers_count number of threads to start, at least 1
+         */
+        explicit Scheduler(std::size_t workers_count);
+
+        /**
+         * @brief Run the remaining tasks then stop the workers
+         *
+         */
+        ~Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        /**
+         * @brief Queue a task, on the queue of the current worker if called from one
+         *
+         * @param task
+         * @param yielded true if the task is a coroutine giving back its thread, so that the other tasks of the queue are run first
+         */
+        void submit(Task* task, bool yielded = false);
+
+        /**
+         * @brief Take a pending task from any queue and run it on the current thread
+         *
+         * @return true if a task was found
+         */
+        bool runPendingTask();
+
+        /**
+         * @brief Get the number of threads running the tasks
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] std::size_t workersCount() const noexcept { return m_workers.size(); }
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Task*> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;  ///< Protects the sleep of the workers
+        std::condition_variable m_wake_up;
+        std::atomic<std::size_t> m_pending;     ///< Number of tasks in the queues
+        std::atomic<std::size_t> m_next_queue;  ///< Queue used by the next task submitted from outside the workers
+        bool m_stop;
+
+        /**
+         * @brief Take a task, from the back of the given queue or from the front of the other ones
+         *
+         * @param index index of the queue to look into first
+         * @return Task* nullptr if all the queues are empty
+         */
+        Task* take(std::size_t index);
+
+        /**
+         * @brief Main loop of a worker
+         *
+         * @param index index of the worker, and of its queue
+         */
+        void work(std::size_t index);
+    };
+}
+
+#endif
@@ -2,7 +2,7 @@
  * @file Scope.hpp
  * @author Alexandre Plateau (lexplt.dev@gmail.com)
  * @brief The virtual machine scope system
- * @version 0.2
+ * @version 0.3
  * @date 2020-10-27
  *
  * @copyright Copyright (c) 2020-2024
@@ -12,7 +12,9 @@
 #ifndef ARK_VM_SCOPE_HPP
 #define ARK_VM_SCOPE_HPP
 
+#include <array>
 #include <vector>
+#include <memory>
 #include <cinttypes>
 
 #include <Ark/Platform.hpp>
@@ -27,6 +29,12 @@ namespace Ark::internal
     class Scope
     {
     public:
+        /// Number of consecutive symbol ids grouped together in a ScopeSnapshot
+        static constexpr std::size_t SnapshotChunkSize = 64;
+
+        /// Memory holding the values of a scope, which can be reused by another one
+        using Storage = std::vector<std::pair<uint16_t, Value>>;
+
         /**
          * @brief Construct a new Scope object
          *
@@ -34,11 +42,27 @@ namespace Ark::internal
         Scope() noexcept;
 
         /**
-         * @brief Merge values from this scope as refs in the other scope
-         * @details This scope must be kept alive for the ref to be used
-         * @param other
+         * @brief Construct a new Scope object, reusing the memory released by another scope
+         *
+         * @param storage an empty storage, with memory already allocated
+         */
+        explicit Scope(Storage&& storage) noexcept;
+
+        /**
+         * @brief Construct a new Scope object, with a table indexed by symbol id to find values in constant time
+         * @details Used for the global scope, which can hold a lot of values
+         *
+         * @param symbols_count number of symbols in the program, used to size the table
          */
-        void mergeRefInto(Scope& other);
+        explicit Scope(std::size_t symbols_count) noexcept;
+
+        /**
+         * @brief Destroy the values of the scope and release their storage, without freeing its memory
+         * @details The scope is left empty
+         *
+         * @return Storage
+         */
+        Storage releaseStorage() noexcept;
 
         /**
          * @brief Put a value in the scope
@@ -81,6 +105,55 @@ namespace Ark::internal
          */
         const Value* operator[](uint16_t id_to_look_for) const noexcept;
 
+        /**
+         * @brief Get a value from its symbol id, in an indexed scope
+         *
+         * @param id_to_look_for
+         * @return Value* Returns nullptr if the value can not be found
+         */
+        [[nodiscard]] inline Value* fromIndex(const uint16_t id_to_look_for) noexcept
+        {
+            if (id_to_look_for < m_index.size() && m_index[id_to_look_for] != 0)
+                return &m_data[m_index[id_to_look_for] - 1].second;
+            return nullptr;
+        }
+
+        /**
+         * @brief Record that the value of a symbol was changed, so that the next snapshot of this scope copies it
+         * @details Does nothing if the scope isn't indexed
+         *
+         * @param id The symbol id of the variable
+         */
+        inline void markModified(const uint16_t id) noexcept
+        {
+            if (const std::size_t chunk = id / SnapshotChunkSize; chunk < m_modified_chunks.size())
+            {
+                m_modified_chunks[chunk] = 1;
+                m_modified = true;
+            }
+        }
+
+        /**
+         * @brief Record that a value was modified in place, if it is stored in this scope
+         * @details Does nothing if the scope isn't indexed
+         *
+         * @param value pointer to the modified value, which may be stored elsewhere
+         */
+        void markModified(const Value* value) noexcept;
+
+        /**
+         * @brief Check if a value was added or changed since the last snapshot of this scope
+         *
+         * @return true if a new snapshot is needed
+         */
+        [[nodiscard]] bool modifiedSinceSnapshot() const noexcept { return m_modified; }
+
+        /**
+         * @brief Mark all the values as unmodified, for a scope filled on top of an existing snapshot
+         *
+         */
+        void resetModified() noexcept;
+
         /**
          * @brief Get the id of a variable based on its value ; used for debug only
          *
@@ -100,12 +173,51 @@ namespace Ark::internal
 
         friend class Ark::VM;
         friend class Ark::internal::Closure;
+        friend class ScopeSnapshot;
 
     private:
-        std::vector<std::pair<uint16_t, Value>> m_data;
+        Storage m_data;
+        std::vector<uint32_t> m_index;           ///< Position + 1 in m_data of each symbol id, 0 if absent. Empty if the scope isn't indexed
+        std::vector<uint8_t> m_modified_chunks;  ///< For each chunk of symbol ids, 1 if a value changed since the last snapshot. Empty if the scope isn't indexed
+        bool m_modified;                         ///< True if any chunk was modified since the last snapshot
         uint16_t m_min_id;  ///< Minimum stored ID, used for a basic bloom filter
         uint16_t m_max_id;  ///< Maximum stored ID, used for a basic bloom filter
     };
+
+    /**
+     * @brief Immutable copy of an indexed scope, shared by the execution contexts created by async and spawn
+     * @details The values are grouped by chunks of symbol ids: a new snapshot shares the chunks of the
+     *          previous one, and only copies the chunks modified since then.
+     */
+    class ScopeSnapshot
+    {
+    public:
+        /**
+         * @brief Take a snapshot of an indexed scope
+         *
+         * @param scope indexed scope, marked as unmodified afterward
+         * @param previous previous snapshot of the same scope, to reuse its unmodified chunks and the values
+         *                 missing from the scope. Can be nullptr
+         */
+        ScopeSnapshot(Scope& scope, const ScopeSnapshot* previous);
+
+        /**
+         * @brief Get a value from its symbol id
+         *
+         * @param id
+         * @return const Value* Returns nullptr if the symbol wasn't bound when the snapshot was taken
+         */
+        [[nodiscard]] const Value* operator[](uint16_t id) const noexcept;
+
+    private:
+        struct Chunk
+        {
+            std::array<Value, Scope::SnapshotChunkSize> values;
+            uint64_t bound = 0;  ///< Bit i is set if values[i] is bound
+        };
+
+        std::vector<std::shared_ptr<const Chunk>> m_chunks;
+    };
 }
 
 #endif
@@ -19,6 +19,7 @@
 #include <Ark/Constants.hpp>
 
 #include <Ark/VM/Value.hpp>
+#include <Ark/VM/DecodedInstruction.hpp>
 #include <Ark/Compiler/Common.hpp>
 #include <Ark/Exceptions.hpp>
 
@@ -105,6 +106,24 @@ namespace Ark
          */
         void setLibDirs(const std::vector<std::filesystem::path>& libenv) noexcept;
 
+        /**
+         * @brief Set the size of the stacks of the execution contexts, must be called before creating the VM
+         * @details The stacks start small and grow when needed, up to the maximum size. Exceeding it
+         *          is reported as a too deep recursion.
+         *
+         * @param initial_size number of values a new stack can hold
+         * @param max_size maximum number of values on a stack
+         */
+        void setStackSize(std::size_t initial_size, std::size_t max_size) noexcept;
+
+        /**
+         * @brief Set the number of threads running the futures created by async, must be called before creating the VM
+         * @details The threads are only started when the first future is created.
+         *
+         * @param count number of threads, 0 to use one thread per hardware thread
+         */
+        void setWorkersCount(std::size_t count) noexcept;
+
         /**
          * @brief Reset State (all member variables related to execution)
          *
@@ -123,6 +142,13 @@ namespace Ark
          */
         void configure(const BytecodeReader& bcr);
 
+        /**
+         * @brief Replace the string held by a constant by the interned string with the same content
+         *
+         * @param constant string constant, read from the bytecode
+         */
+        void intern(Value& constant);
+
         /**
          * @brief Reads and compiles code of file
          *
@@ -144,11 +170,15 @@ namespace Ark
         bytecode_t m_bytecode;
         std::vector<std::filesystem::path> m_libenv;
         std::string m_filename;
+        std::size_t m_stack_initial_size;
+        std::size_t m_stack_max_size;
+        std::size_t m_workers_count;
 
         // related to the bytecode
         std::vector<std::string> m_symbols;
         std::vector<Value> m_constants;
-        std::vector<bytecode_t> m_pages;
+        std::unordered_map<std::string, Value> m_interned_strings;  ///< Strings of the constants tables, kept across reconfigurations so that equal strings always share the same cell
+        std::vector<internal::DecodedPage> m_pages;  ///< Code pages, decoded once so that the VM can fetch an instruction in a single load
 
         // related to the execution
         std::unordered_map<std::string, Value> m_binded;
@@ -13,6 +13,7 @@
 #define ARK_VM_VM_HPP
 
 #include <array>
+#include <atomic>
 #include <vector>
 #include <string>
 #include <cassert>
@@ -20,6 +21,7 @@
 #include <cinttypes>
 #include <unordered_map>
 #include <algorithm>
+#include <functional>
 #include <fmt/core.h>
 
 #include <Ark/Compiler/Instructions.hpp>
@@ -31,6 +33,9 @@
 #include <Ark/Platform.hpp>
 #include <Ark/VM/Plugin.hpp>
 #include <Ark/VM/Future.hpp>
+#include <Ark/VM/Coroutine.hpp>
+#include <Ark/VM/Scheduler.hpp>
+#include <Ark/VM/Jit.hpp>
 
 namespace Ark
 {
@@ -125,7 +130,7 @@ namespace Ark
         void deleteContext(internal::ExecutionContext* ec);
 
         /**
-         * @brief Create a Future object from a function and its arguments and return a managed pointer to it
+         * @brief Create a Future object from a function and its arguments, give it to the scheduler and return a managed pointer to it
          * @details This method is thread-safe VM wise.
          *
          * @param args
@@ -133,6 +138,25 @@ namespace Ark
          */
         internal::Future* createFuture(std::vector<Value>& args);
 
+        /**
+         * @brief Create a Coroutine from a function and its arguments, give it to the scheduler and return a managed pointer to it
+         * @details This method is thread-safe VM wise.
+         *
+         * @param args
+         * @return internal::Coroutine*
+         */
+        internal::Coroutine* createCoroutine(std::vector<Value>& args);
+
+        /**
+         * @brief Process the indices [0, count[ by chunks on the threads of the futures, each chunk on its own execution context
+         * @details Blocks until all the chunks are processed, the current thread running pending tasks meanwhile. The first
+         *          exception thrown while processing a chunk is rethrown. This method is thread-safe VM wise.
+         *
+         * @param count number of indices to process
+         * @param process called with the execution context of a chunk and its range of indices [begin, end[
+         */
+        void parallelFor(std::size_t count, const std::function<void(internal::ExecutionContext&, std::size_t, std::size_t)>& process);
+
         /**
          * @brief Free a given future
          * @details This method is thread-safe VM wise.
@@ -141,6 +165,16 @@ namespace Ark
          */
         void deleteFuture(internal::Future* f);
 
+        /**
+         * @brief Compile the loops run many times by the main execution context to native code
+         * @details Only the numeric instructions are compiled, the code goes back to the interpreter for everything else.
+         *          Available on x86-64 Linux, when ArkScript was built with ARK_ENABLE_JIT.
+         *
+         * @return true if the JIT is available
+         * @return false otherwise, the code is interpreted
+         */
+        bool enableJit();
+
         /**
          * @brief Used by the REPL to force reload all the plugins and their bound methods
          *
@@ -152,6 +186,8 @@ namespace Ark
         friend class Value;
         friend class internal::Closure;
         friend class Repl;
+        friend class internal::Future;
+        friend class internal::Coroutine;
 
     private:
         State& m_state;
@@ -161,11 +197,20 @@ namespace Ark
         std::mutex m_mutex;
         std::vector<std::shared_ptr<internal::SharedLibrary>> m_shared_lib_objects;
         std::vector<std::unique_ptr<internal::Future>> m_futures;  ///< Storing the promises while we are resolving them
+        std::vector<std::unique_ptr<internal::Coroutine>> m_coroutines;
+        std::vector<internal::ThreadedPage> m_threaded_pages;      ///< Code pages with the address of each instruction implementation, computed by the first safeRun after prepareCode
+        std::atomic<bool> m_pages_threaded { false };             ///< True once m_threaded_pages has been computed, written under m_mutex
+        std::vector<std::vector<std::atomic<uint16_t>>> m_field_caches;  ///< Inline cache of each instruction reading a field, by page and instruction: slot of the field in the last closure read. Computed by prepareCode
+        std::unique_ptr<internal::Jit> m_jit;  ///< Native code of the hot pages, nullptr unless enableJit was called
+        std::vector<Value*> m_jit_variables;   ///< Variables used by the native code being run, found when entering it
 
         // a little trick for operator[] and for pop
         Value m_no_value = internal::Builtins::nil;
         Value m_undefined_value;
 
+        // declared last so that the workers are stopped before the futures and the contexts are destroyed
+        std::unique_ptr<internal::Scheduler> m_scheduler;  ///< Runs the futures, created with the first one
+
         /**
          * @brief Run ArkScript bytecode inside a try catch to retrieve all the exceptions and display a stack trace if needed
          *
@@ -182,14 +227,64 @@ namespace Ark
          */
         void init() noexcept;
 
+        /**
+         * @brief Drop what was computed from the previous code, once the futures and the coroutines still queued are done
+         * @details Builds the inline caches of the current code, the threaded pages will be built by the next safeRun.
+         *          Must be called before running new code, while no execution context is running
+         *
+         */
+        void prepareCode() noexcept;
+
+        /**
+         * @brief Create an execution context, the caller must hold m_mutex
+         * @details The new context starts with the frames and the globals of the context run by the current
+         *          thread, or of the primary one if none is running
+         *
+         * @return internal::ExecutionContext*
+         */
+        internal::ExecutionContext* createContext();
+
+        /**
+         * @brief Start the scheduler if it isn't already, the caller must hold m_mutex
+         *
+         * @return internal::Scheduler&
+         */
+        internal::Scheduler& getScheduler();
+
+        /**
+         * @brief Continue a loop of the main execution context in native code, once its page is hot
+         * @details Called by a backward JUMP, after setting the instruction pointer to the start of the loop.
+         *          Updates the instruction pointer and the stack of the context to where the native code stopped.
+         *
+         * @param context
+         * @param jump index of the JUMP instruction
+         */
+        void runNativeCode(internal::ExecutionContext& context, std::size_t jump);
+
         // ================================================
         //               instruction helpers
         // ================================================
 
         inline Value* loadSymbol(uint16_t id, internal::ExecutionContext& context);
+        inline Value* loadLocal(uint16_t slot, internal::ExecutionContext& context);
+        inline Value* loadUpvalue(uint16_t slot, internal::ExecutionContext& context);
+        inline Value* loadGlobal(uint16_t id, internal::ExecutionContext& context);
+
+        /**
+         * @brief Find a field in the scope of a closure, trying first the slot where the same instruction last found it
+         *
+         * @param closure
+         * @param id symbol id of the field
+         * @param cache inline cache of the instruction, updated when the field is found at another slot
+         * @return Value* nullptr if the closure doesn't have this field
+         */
+        inline Value* getField(internal::Closure& closure, uint16_t id, std::atomic<uint16_t>& cache) noexcept;
+
         inline Value* loadConstAsPtr(uint16_t id) const;
         inline void store(uint16_t id, const Value* val, internal::ExecutionContext& context);
         inline void setVal(uint16_t id, const Value* val, internal::ExecutionContext& context);
+        inline void setLocal(uint16_t slot, const Value* val, internal::ExecutionContext& context);
+        inline void setGlobal(uint16_t id, const Value* val, internal::ExecutionContext& context);
 
         // ================================================
         //                 stack related
@@ -227,6 +322,13 @@ namespace Ark
          */
         inline void push(Value* valptr, internal::ExecutionContext& context);
 
+        /**
+         * @brief Double the size of the stack of an execution context, up to the maximum size set in the State
+         *
+         * @param context
+         */
+        void growStack(internal::ExecutionContext& context);
+
         /**
          * @brief Pop a value from the stack and resolve it if possible, then return it
          *
@@ -236,15 +338,27 @@ namespace Ark
         inline Value* popAndResolveAsPtr(internal::ExecutionContext& context);
 
         /**
-         * @brief Move stack values around and invert them
-         * @details values:     1,  2, 3, _, _
-         *          wanted:    pp, ip, 3, 2, 1
-         *          positions:  0,  1, 2, 3, 4
+         * @brief Read the two operands of a binary operator, without popping them, if they are both numbers
+         *
+         * @param context
+         * @param a first operand
+         * @param b second operand
+         * @return true if both operands are numbers
+         */
+        inline bool peekNumbers(internal::ExecutionContext& context, double& a, double& b) noexcept;
+
+        /**
+         * @brief Move the arguments of a function call from the stack to the current frame, and push the return address
+         * @details The arguments are stored in the order of the STORE instructions at the beginning of
+         *          the function page, so that the compiler can access them by slot. The page and
+         *          instruction pointers are then set to the first instruction after the arguments.
          *
-         * @param argc number of arguments to swap around
+         * @param argc number of arguments on the stack
+         * @param page_addr page of the called function
          * @param context
+         * @return uint16_t number of arguments needed by the function
          */
-        inline void swapStackForFunCall(uint16_t argc, internal::ExecutionContext& context);
+        inline uint16_t storeArgsForFunCall(uint16_t argc, internal::PageAddr_t page_addr, internal::ExecutionContext& context);
 
         // ================================================
         //                locals related
@@ -259,6 +373,23 @@ namespace Ark
          */
         inline Value* findNearestVariable(uint16_t id, internal::ExecutionContext& context) noexcept;
 
+        /**
+         * @brief Copy a global from the snapshot of the context into its global scope
+         *
+         * @param id the id to find
+         * @param context
+         * @return Value* nullptr if the context has no snapshot, or if the variable isn't in it
+         */
+        inline Value* loadFromSnapshot(uint16_t id, internal::ExecutionContext& context) noexcept;
+
+        /**
+         * @brief Create the scope of a new frame, reusing the memory of a frame which returned if possible
+         *
+         * @param context
+         * @return internal::Scope& the new scope
+         */
+        inline internal::Scope& pushFrameScope(internal::ExecutionContext& context);
+
         /**
          * @brief Destroy the current frame and get back to the previous one, resuming execution
          *
@@ -315,6 +446,49 @@ namespace Ark
          */
         inline void call(internal::ExecutionContext& context, uint16_t argc);
 
+        /**
+         * @brief Call a function with a closure scope as its environment
+         * @details Same as calling a closure made of the scope and the function, without needing to create it.
+         *          Used to call the methods of a closure.
+         *
+         * @param context
+         * @param scope scope of the closure
+         * @param page_addr page of the function
+         * @param argc number of arguments already sent
+         */
+        inline void callClosure(internal::ExecutionContext& context, const std::shared_ptr<internal::Scope>& scope, internal::PageAddr_t page_addr, uint16_t argc);
+
+        /**
+         * @brief Throw an error for a function called with the wrong number of arguments
+         *
+         * @param needed_argc number of arguments of the function
+         * @param argc number of arguments given
+         * @param context
+         */
+        void throwArityError(uint16_t needed_argc, uint16_t argc, internal::ExecutionContext& context);
+
+        /**
+         * @brief Throw an error for a field read on a value which isn't a closure
+         *
+         * @param value value we tried to read a field from
+         * @param field symbol id of the field
+         * @param context
+         */
+        void throwNotAClosureError(const Value& value, uint16_t field, internal::ExecutionContext& context);
+
+        /**
+         * @brief Function called when the TAIL_CALL instruction is met in the bytecode
+         * @details The current frame is replaced by the frame of the called function, which returns directly
+         *          to the caller of the current function, thus the stack does not grow. The variables of the
+         *          current frame are moved to the new one (after the arguments), so that they can still be found,
+         *          and a function called from a closure shares its closure scope. A closure calling another
+         *          closure makes a regular call instead.
+         *
+         * @param context
+         * @param argc number of arguments already sent
+         */
+        inline void tailCall(internal::ExecutionContext& context, uint16_t argc);
+
         /**
          * @brief Builtin called when the CALL_BUILTIN instruction is met in the bytecode
          *
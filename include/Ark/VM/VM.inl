@@ -33,15 +33,12 @@ Value VM::call(const std::string& name, Args&&... args)
     }
 
     const std::size_t frames_count = context.fc;
-    // call it
+    // call it, the instruction pointer is set after the arguments of the function
     call(context, static_cast<int16_t>(sizeof...(Args)));
-    // reset instruction pointer, otherwise the safeRun method will start at ip = -1
-    // without doing context.ip++ as intended (done right after the call() in the loop, but here
-    // we start outside this loop)
-    context.ip = 0;
 
     // run until the function returns
-    safeRun(context, /* untilFrameCount */ frames_count);
+    if (context.fc > frames_count)
+        safeRun(context, /* untilFrameCount */ frames_count);
 
     // get result
     return *popAndResolveAsPtr(context);
@@ -69,15 +66,12 @@ Value VM::resolve(const Value* val, Args&&... args)
     push(*val, context);
 
     const std::size_t frames_count = context.fc;
-    // call it
+    // call it, the instruction pointer is set after the arguments of the function
     call(context, static_cast<uint16_t>(sizeof...(Args)));
-    // reset instruction pointer, otherwise the safeRun method will start at ip = -1
-    // without doing context.ip++ as intended (done right after the call() in the loop, but here
-    // we start outside this loop)
-    context.ip = 0;
 
     // run until the function returns
-    safeRun(context, /* untilFrameCount */ frames_count);
+    if (context.fc > frames_count)
+        safeRun(context, /* untilFrameCount */ frames_count);
 
     // restore VM state
     context.ip = ip;
@@ -101,15 +95,12 @@ inline Value VM::resolve(internal::ExecutionContext* context, std::vector<Value>
     push(n[0], *context);
 
     const std::size_t frames_count = context->fc;
-    // call it
+    // call it, the instruction pointer is set after the arguments of the function
     call(*context, static_cast<uint16_t>(n.size() - 1));
-    // reset instruction pointer, otherwise the safeRun method will start at ip = -1
-    // without doing context.ip++ as intended (done right after the call() in the loop, but here
-    // we start outside this loop)
-    context->ip = 0;
 
     // run until the function returns
-    safeRun(*context, /* untilFrameCount */ frames_count);
+    if (context->fc > frames_count)
+        safeRun(*context, /* untilFrameCount */ frames_count);
 
     // restore VM state
     context->ip = ip;
@@ -136,6 +127,75 @@ inline Value* VM::loadSymbol(const uint16_t id, internal::ExecutionContext& cont
     return nullptr;
 }
 
+inline Value* VM::loadLocal(const uint16_t slot, internal::ExecutionContext& context)
+{
+    internal::Scope& scope = context.locals.back();
+    if (slot >= scope.m_data.size()) [[unlikely]]
+        throwVMError(internal::ErrorKind::Scope, fmt::format("Unbound local variable in slot {}", slot));
+
+    auto& [id, value] = scope.m_data[slot];
+    context.last_symbol = id;
+    if (value.valueType() == ValueType::Reference)
+        return value.reference();
+    // a deleted argument keeps its slot, with an undefined value
+    if (value.valueType() == ValueType::Undefined) [[unlikely]]
+        throwVMError(internal::ErrorKind::Scope, fmt::format("Unbound variable `{}'", m_state.m_symbols[id]));
+    return &value;
+}
+
+inline Value* VM::loadUpvalue(const uint16_t slot, internal::ExecutionContext& context)
+{
+    const std::shared_ptr<internal::Scope>& closure_scope = context.stacked_closure_scopes.back();
+    if (closure_scope == nullptr || slot >= closure_scope->m_data.size()) [[unlikely]]
+        throwVMError(internal::ErrorKind::Scope, fmt::format("Unbound captured variable in slot {}", slot));
+
+    auto& [id, value] = closure_scope->m_data[slot];
+    context.last_symbol = id;
+    if (value.valueType() == ValueType::Reference)
+        return value.reference();
+    // a deleted captured variable keeps its slot, with an undefined value
+    if (value.valueType() == ValueType::Undefined) [[unlikely]]
+        throwVMError(internal::ErrorKind::Scope, fmt::format("Unbound variable `{}'", m_state.m_symbols[id]));
+    return &value;
+}
+
+inline Value* VM::getField(internal::Closure& closure, const uint16_t id, std::atomic<uint16_t>& cache) noexcept
+{
+    const auto& fields = closure.refScope().m_data;
+
+    // the closures made by the same instruction have their fields in the same order
+    if (const uint16_t slot = cache.load(std::memory_order_relaxed); slot < fields.size() && fields[slot].first == id) [[likely]]
+        return &closure.refScope().m_data[slot].second;
+
+    for (std::size_t slot = 0, end = fields.size(); slot < end; ++slot)
+    {
+        if (fields[slot].first == id)
+        {
+            cache.store(static_cast<uint16_t>(slot), std::memory_order_relaxed);
+            return &closure.refScope().m_data[slot].second;
+        }
+    }
+    return nullptr;
+}
+
+inline Value* VM::loadGlobal(const uint16_t id, internal::ExecutionContext& context)
+{
+    context.last_symbol = id;
+    Value* var = context.locals.front().fromIndex(id);
+    if (var == nullptr) [[unlikely]]
+        var = loadFromSnapshot(id, context);
+
+    if (var != nullptr) [[likely]]
+    {
+        if (var->valueType() == ValueType::Reference)
+            return var->reference();
+        return var;
+    }
+    else [[unlikely]]
+        throwVMError(internal::ErrorKind::Scope, fmt::format("Unbound variable `{}'", m_state.m_symbols[id]));
+    return nullptr;
+}
+
 inline Value* VM::loadConstAsPtr(const uint16_t id) const
 {
     return &m_state.m_constants[id];
@@ -148,7 +208,10 @@ inline void VM::store(const uint16_t id, const Value* val, internal::ExecutionCo
     if (local == nullptr) [[likely]]
         context.locals.back().push_back(id, *val);
     else
+    {
         *local = *val;
+        context.locals.back().markModified(id);
+    }
 }
 
 inline void VM::setVal(const uint16_t id, const Value* val, internal::ExecutionContext& context)
@@ -159,6 +222,52 @@ inline void VM::setVal(const uint16_t id, const Value* val, internal::ExecutionC
             *var->reference() = *val;
         else [[likely]]
             *var = *val;
+        // the variable may be a global
+        context.locals.front().markModified(id);
+    }
+    else
+        throwVMError(
+            internal::ErrorKind::Scope,
+            fmt::format(
+                "Unbound variable `{}', can not change its value to {}",
+                m_state.m_symbols[id],
+                val->toString(*this)));
+}
+
+inline void VM::setLocal(const uint16_t slot, const Value* val, internal::ExecutionContext& context)
+{
+    internal::Scope& scope = context.locals.back();
+    if (slot >= scope.m_data.size()) [[unlikely]]
+        throwVMError(internal::ErrorKind::Scope, fmt::format("Unbound local variable in slot {}", slot));
+
+    auto& [id, local] = scope.m_data[slot];
+    if (local.valueType() == ValueType::Reference)
+        *local.reference() = *val;
+    // a deleted argument can only be bound again by let or mut
+    else if (local.valueType() == ValueType::Undefined) [[unlikely]]
+        throwVMError(
+            internal::ErrorKind::Scope,
+            fmt::format(
+                "Unbound variable `{}', can not change its value to {}",
+                m_state.m_symbols[id],
+                val->toString(*this)));
+    else
+        local = *val;
+}
+
+inline void VM::setGlobal(const uint16_t id, const Value* val, internal::ExecutionContext& context)
+{
+    Value* var = context.locals.front().fromIndex(id);
+    if (var == nullptr) [[unlikely]]
+        var = loadFromSnapshot(id, context);
+
+    if (var != nullptr) [[likely]]
+    {
+        if (var->valueType() == ValueType::Reference)
+            *var->reference() = *val;
+        else [[likely]]
+            *var = *val;
+        context.locals.front().markModified(id);
     }
     else
         throwVMError(
@@ -185,23 +294,34 @@ inline Value* VM::pop(internal::ExecutionContext& context)
 
 inline void VM::push(const Value& value, internal::ExecutionContext& context)
 {
-    context.stack[context.sp].m_type = value.m_type;
-    context.stack[context.sp].m_value = value.m_value;
+    if (context.sp == context.stack.size()) [[unlikely]]
+    {
+        // the value may be on the stack, copy it before growing the stack
+        Value copy = value;
+        growStack(context);
+        context.stack[context.sp] = std::move(copy);
+    }
+    else
+        context.stack[context.sp] = value;
     ++context.sp;
 }
 
 inline void VM::push(Value&& value, internal::ExecutionContext& context)
 {
-    context.stack[context.sp].m_type = std::move(value.m_type);
-    context.stack[context.sp].m_value = std::move(value.m_value);
+    if (context.sp == context.stack.size()) [[unlikely]]
+    {
+        Value moved = std::move(value);
+        growStack(context);
+        context.stack[context.sp] = std::move(moved);
+    }
+    else
+        context.stack[context.sp] = std::move(value);
     ++context.sp;
 }
 
 inline void VM::push(Value* valptr, internal::ExecutionContext& context)
 {
-    context.stack[context.sp].m_type = ValueType::Reference;
-    context.stack[context.sp].m_value = valptr;
-    ++context.sp;
+    push(Value(valptr), context);
 }
 
 inline Value* VM::popAndResolveAsPtr(internal::ExecutionContext& context)
@@ -212,78 +332,116 @@ inline Value* VM::popAndResolveAsPtr(internal::ExecutionContext& context)
     return tmp;
 }
 
-inline void VM::swapStackForFunCall(const uint16_t argc, internal::ExecutionContext& context)
+inline bool VM::peekNumbers(internal::ExecutionContext& context, double& a, double& b) noexcept
 {
-    using namespace internal;
+    const Value* lhs = &context.stack[context.sp - 2];
+    if (lhs->valueType() == ValueType::Reference)
+        lhs = lhs->reference();
+    const Value* rhs = &context.stack[context.sp - 1];
+    if (rhs->valueType() == ValueType::Reference)
+        rhs = rhs->reference();
+
+    if (lhs->valueType() != ValueType::Number || rhs->valueType() != ValueType::Number)
+        return false;
+    a = lhs->number();
+    b = rhs->number();
+    return true;
+}
 
-    // move values around and invert them
-    //
-    // values:     1,  2, 3, _, _
-    // wanted:    pp, ip, 3, 2, 1
-    // positions:  0,  1, 2, 3, 4
-    //
-    // move values first, from position x to y, with
-    //    y = argc - x + 1
-    // then place pp and ip
-    switch (argc)  // must be positive
-    {
-        case 0:
-            push(Value(static_cast<PageAddr_t>(context.pp)), context);
-            push(Value(ValueType::InstPtr, static_cast<PageAddr_t>(context.ip)), context);
-            break;
+inline uint16_t VM::storeArgsForFunCall(const uint16_t argc, const internal::PageAddr_t page_addr, internal::ExecutionContext& context)
+{
+    using namespace internal;
 
-        case 1:
-            context.stack[context.sp + 1] = context.stack[context.sp - 1];
-            context.stack[context.sp - 1] = Value(static_cast<PageAddr_t>(context.pp));
-            context.stack[context.sp + 0] = Value(ValueType::InstPtr, static_cast<PageAddr_t>(context.ip));
-            context.sp += 2;
-            break;
+    // every argument is a STORE instruction at the beginning of the page, the arguments
+    // are stored in that order so that the n-th argument is always in the n-th slot
+    const auto& page = m_state.m_pages[page_addr];
+    const auto first = static_cast<std::size_t>(context.sp - argc);
+    Scope& frame = context.locals.back();
 
-        default:  // 2 or more elements
+    uint16_t needed_argc = 0;
+    std::size_t index = 0;
+    while (index < page.size() && page[index].inst == STORE)
+    {
+        if (needed_argc < argc)
         {
-            const auto first = static_cast<int16_t>(context.sp - argc);
-            // move first argument to the very end
-            context.stack[context.sp + 1] = context.stack[static_cast<std::size_t>(first + 0)];
-            //  move second argument right before the last one
-            context.stack[context.sp + 0] = context.stack[static_cast<std::size_t>(first + 1)];
-            //  move the rest, if any
-            uint16_t x = 2;
-            const uint16_t stop = ((argc % 2 == 0) ? argc : (argc - 1)) / 2;
-            while (x <= stop)
-            {
-                // destination, origin
-                std::swap(
-                    context.stack[static_cast<std::size_t>(context.sp - x + 1)],
-                    context.stack[static_cast<std::size_t>(first + x)]);
-                ++x;
-            }
-            context.stack[static_cast<std::size_t>(first + 0)] = Value(static_cast<PageAddr_t>(context.pp));
-            context.stack[static_cast<std::size_t>(first + 1)] = Value(ValueType::InstPtr, static_cast<PageAddr_t>(context.ip));
-            context.sp += 2;
-            break;
+            const uint16_t id = page[index].arg;
+            Value& arg = context.stack[first + needed_argc];
+
+            Value* local = frame[id];
+            if (local == nullptr) [[likely]]
+                frame.push_back(id, arg.valueType() == ValueType::Reference ? *arg.reference() : std::move(arg));
+            else
+                *local = arg.valueType() == ValueType::Reference ? *arg.reference() : std::move(arg);
         }
+
+        ++needed_argc;
+        ++index;
     }
 
+    // the arguments are replaced by the return address
+    context.sp -= argc;
+    push(Value(static_cast<PageAddr_t>(context.pp)), context);
+    push(Value(ValueType::InstPtr, static_cast<PageAddr_t>(context.ip)), context);
     context.fc++;
+
+    context.pp = page_addr;
+    // skip the STORE instructions, the arguments are already in the frame
+    context.ip = index;
+
+    return needed_argc;
 }
 
 #pragma endregion
 
 inline Value* VM::findNearestVariable(const uint16_t id, internal::ExecutionContext& context) noexcept
 {
-    for (auto it = context.locals.rbegin(), it_end = context.locals.rend(); it != it_end; ++it)
+    for (std::size_t i = context.locals.size(); i-- > 0;)
     {
-        if (const auto val = (*it)[id]; val != nullptr)
+        if (const auto val = context.locals[i][id]; val != nullptr)
             return val;
+        // the environment of a closure comes after the arguments and the variables of its frame, which can shadow it
+        if (const auto& closure_scope = context.stacked_closure_scopes[i]; closure_scope != nullptr)
+        {
+            if (const auto val = (*closure_scope)[id]; val != nullptr)
+                return val;
+        }
     }
-    return nullptr;
+    return loadFromSnapshot(id, context);
+}
+
+inline Value* VM::loadFromSnapshot(const uint16_t id, internal::ExecutionContext& context) noexcept
+{
+    if (context.globals_snapshot == nullptr)
+        return nullptr;
+
+    const Value* val = (*context.globals_snapshot)[id];
+    if (val == nullptr)
+        return nullptr;
+
+    // copy the value in the context, so that it can be modified without changing the snapshot
+    internal::Scope& globals = context.locals.front();
+    globals.push_back(id, *val);
+    return globals.fromIndex(id);
+}
+
+inline internal::Scope& VM::pushFrameScope(internal::ExecutionContext& context)
+{
+    if (context.free_scopes.empty())
+        return context.locals.emplace_back();
+
+    internal::Scope& scope = context.locals.emplace_back(std::move(context.free_scopes.back()));
+    context.free_scopes.pop_back();
+    return scope;
 }
 
 inline void VM::returnFromFuncCall(internal::ExecutionContext& context)
 {
     --context.fc;
     context.stacked_closure_scopes.pop_back();
-    // NOTE: high cpu cost because destroying variants cost
+    // NOTE: high cpu cost because destroying values cost
+    // the memory of the scope is kept for the next call, so that calling a function doesn't allocate
+    if (internal::Scope::Storage storage = context.locals.back().releaseStorage(); storage.capacity() != 0)
+        context.free_scopes.push_back(std::move(storage));
     context.locals.pop_back();
 }
 
@@ -292,76 +450,43 @@ inline void VM::call(internal::ExecutionContext& context, const uint16_t argc)
     /*
         Argument: number of arguments when calling the function
         Job: Call function from its symbol id located on top of the stack. Take the given number of
-                arguments from the top of stack and give them  to the function (the first argument taken
-                from the stack will be the last one of the function). The stack of the function is now composed
-                of its arguments, from the first to the last one
+                arguments from the top of stack and store them in the new frame, in the order of declaration
+                of the function arguments. The stack of the function now starts with the return address
     */
     using namespace internal;
 
     Value function = *popAndResolveAsPtr(context);
-    context.stacked_closure_scopes.emplace_back(nullptr);
+    uint16_t needed_argc = 0;
 
     switch (function.valueType())
     {
         // is it a builtin function name?
         case ValueType::CProc:
         {
-            // drop arguments from the stack
-            std::vector<Value> args;
-            args.reserve(argc);
-
-            for (uint16_t j = 0; j < argc; ++j)
-            {
-                // because we pull `argc` from the CALL instruction generated by the compiler,
-                // we are guaranted to have `argc` values pushed on the stack ; thus we can
-                // skip the `if (context.sp > 0)` check
-                Value* val = &context.stack[context.sp - argc + j];
-                if (val->valueType() == ValueType::Reference)
-                    val = val->reference();
-                args.emplace_back(*val);
-            }
-            context.sp -= argc;
-            // call proc
-            push(function.proc()(args, this), context);
-
+            callBuiltin(context, function, argc);
             return;
         }
 
         // is it a user defined function?
         case ValueType::PageAddr:
         {
-            const PageAddr_t new_page_pointer = function.pageAddr();
-
             // create dedicated frame
-            context.locals.emplace_back();
-            swapStackForFunCall(argc, context);
+            pushFrameScope(context);
+            context.stacked_closure_scopes.emplace_back(nullptr);
+            needed_argc = storeArgsForFunCall(argc, function.pageAddr(), context);
 
             // store "reference" to the function to speed the recursive functions
-            if (context.last_symbol < m_state.m_symbols.size()) [[likely]]
+            if (context.last_symbol < m_state.m_symbols.size() && context.locals.back()[context.last_symbol] == nullptr) [[likely]]
                 context.locals.back().push_back(context.last_symbol, function);
-
-            context.pp = new_page_pointer;
-            context.ip = 0;
             break;
         }
 
         // is it a user defined closure?
         case ValueType::Closure:
         {
-            Closure& c = function.refClosure();
-            const PageAddr_t new_page_pointer = c.pageAddr();
-
-            // create dedicated frame
-            context.locals.emplace_back();
-            // load saved scope
-            c.refScope().mergeRefInto(context.locals.back());
-            context.stacked_closure_scopes.back() = c.scopePtr();
-
-            swapStackForFunCall(argc, context);
-
-            context.pp = new_page_pointer;
-            context.ip = 0;
-            break;
+            const Closure& c = function.refClosure();
+            callClosure(context, c.scopePtr(), c.pageAddr(), argc);
+            return;
         }
 
         default:
@@ -382,50 +507,121 @@ inline void VM::call(internal::ExecutionContext& context, const uint16_t argc)
     }
 
     // checking function arity
-    std::size_t index = 0,
-                needed_argc = 0;
+    if (needed_argc != argc) [[unlikely]]
+        throwArityError(needed_argc, argc, context);
+}
 
-    // every argument is a MUT declaration in the bytecode
-    while (m_state.m_pages[context.pp][index] == STORE)
+inline void VM::callClosure(internal::ExecutionContext& context, const std::shared_ptr<internal::Scope>& scope, const internal::PageAddr_t page_addr, const uint16_t argc)
+{
+    // create dedicated frame
+    pushFrameScope(context);
+    context.stacked_closure_scopes.emplace_back(scope);
+    // the captured variables are not copied in the frame: they are loaded by slot from the closure
+    // scope, or found by name right after the arguments, as they can shadow the captured variables
+    if (const uint16_t needed_argc = storeArgsForFunCall(argc, page_addr, context); needed_argc != argc) [[unlikely]]
+        throwArityError(needed_argc, argc, context);
+}
+
+inline void VM::tailCall(internal::ExecutionContext& context, const uint16_t argc)
+{
+    using namespace internal;
+
+    // a frame has room for a single closure scope: when a closure calls another closure, the current frame
+    // is kept so that the callee can still modify the variables captured by the current closure
+    if (const std::shared_ptr<Scope>& current_scope = context.stacked_closure_scopes.back(); current_scope != nullptr)
     {
-        needed_argc += 1;
-        index += 4;  // instructions are on 4 bytes
+        Value& top = context.stack[context.sp - 1];
+        Value& function = top.valueType() == ValueType::Reference ? *top.reference() : top;
+        if (function.valueType() == ValueType::Closure && function.refClosure().scopePtr() != current_scope)
+        {
+            call(context, argc);
+            return;
+        }
     }
 
-    if (needed_argc != argc) [[unlikely]]
+    // the arguments and the function are on top of the stack, right after the return address
+    // of the current function (and the values left by the current function, if any)
+    const std::size_t first = context.sp - argc - 1u;
+    std::size_t return_address = first - 1;
+    while (context.stack[return_address].valueType() != ValueType::InstPtr)
+        --return_address;
+
+    const auto ip = static_cast<std::size_t>(context.stack[return_address].pageAddr());
+    const auto pp = static_cast<std::size_t>(context.stack[return_address - 1].pageAddr());
+
+    // move the arguments and the function in place of the return address, copying the values
+    // they reference as they may belong to the frame we are about to destroy
+    const std::size_t destination = return_address - 1;
+    for (std::size_t i = 0; i <= argc; ++i)
     {
-        if (context.last_symbol < m_state.m_symbols.size())
-            throwVMError(
-                ErrorKind::Arity,
-                fmt::format(
-                    "Function `{}' needs {} arguments, but it received {}",
-                    m_state.m_symbols[context.last_symbol], needed_argc, argc));
-        else
-            throwVMError(
-                ErrorKind::Arity,
-                fmt::format(
-                    "Function at page {} needs {} arguments, but it received {}",
-                    context.pp, needed_argc, argc));
+        Value& val = context.stack[first + i];
+        context.stack[destination + i] = val.valueType() == ValueType::Reference ? *val.reference() : std::move(val);
     }
+    context.sp = destination + argc + 1;
+
+    // the called function can still access the variables of the current one, as it would from a nested frame.
+    // keep the closure scope alive while we move them, some of them may be references to it
+    Scope frame = std::move(context.locals.back());
+    const std::shared_ptr<Scope> closure_scope = context.stacked_closure_scopes.back();
+    const std::size_t frame_count = context.fc;
+
+    returnFromFuncCall(context);
+    context.ip = ip;
+    context.pp = pp;
+
+    call(context, argc);
+
+    // builtins do not create a frame
+    if (context.fc == frame_count)
+    {
+        Scope& new_frame = context.locals.back();
+        const std::shared_ptr<Scope>& new_closure_scope = context.stacked_closure_scopes.back();
+        const auto is_unbound = [&new_frame, &new_closure_scope](const uint16_t id) {
+            return new_frame[id] == nullptr && (new_closure_scope == nullptr || (*new_closure_scope)[id] == nullptr);
+        };
+
+        for (auto& [id, val] : frame.m_data)
+        {
+            if (is_unbound(id))
+                new_frame.push_back(id, val.valueType() == ValueType::Reference ? *val.reference() : std::move(val));
+        }
+        // the variables captured by the current function were visible too, after its own ones. They are shared
+        // instead of copied, so that they keep the values the callee gives them
+        if (new_closure_scope == nullptr)
+            context.stacked_closure_scopes.back() = closure_scope;
+    }
+    context.free_scopes.push_back(frame.releaseStorage());
 }
 
 inline void VM::callBuiltin(internal::ExecutionContext& context, const Value& builtin, const uint16_t argc)
 {
-    // drop arguments from the stack
+    // reuse the memory of the arguments of a previous call, a builtin can call functions calling builtins themselves
     std::vector<Value> args;
+    if (!context.free_args.empty())
+    {
+        args = std::move(context.free_args.back());
+        context.free_args.pop_back();
+    }
     args.reserve(argc);
 
+    // drop arguments from the stack
     for (uint16_t j = 0; j < argc; ++j)
     {
         // because we pull `argc` from the CALL instruction generated by the compiler,
         // we are guaranted to have `argc` values pushed on the stack ; thus we can
         // skip the `if (context.sp > 0)` check
-        Value* val = &context.stack[context.sp - argc + j];
-        if (val->valueType() == ValueType::Reference)
-            val = val->reference();
-        args.emplace_back(*val);
+        Value& val = context.stack[context.sp - argc + j];
+        if (val.valueType() == ValueType::Reference)
+            args.emplace_back(*val.reference());
+        else
+            // the slot is above the stack pointer after the call, it doesn't need to keep its value
+            args.emplace_back(std::move(val));
     }
     context.sp -= argc;
     // call proc
-    push(builtin.proc()(args, this), context);
+    Value result = builtin.proc()(args, this);
+
+    args.clear();
+    context.free_args.push_back(std::move(args));
+    push(std::move(result), context);
 }
@@ -13,10 +13,12 @@
 #define ARK_VM_VALUE_HPP
 
 #include <vector>
-#include <variant>
 #include <string>
 #include <cinttypes>
 #include <array>
+#include <atomic>
+#include <functional>
+#include <type_traits>
 
 #include <Ark/VM/Value/Closure.hpp>
 #include <Ark/VM/Value/UserType.hpp>
@@ -25,6 +27,7 @@
 namespace Ark
 {
     class VM;
+    class State;
     class BytecodeReader;
 
     // Order is important because we are doing some optimizations to check ranges
@@ -56,23 +59,67 @@ namespace Ark
         "InstPtr"
     };
 
+    namespace internal
+    {
+        /**
+         * @brief Reference counted heap cell, used to store objects too big to fit in a Value
+         *
+         * @tparam T type of the stored object
+         */
+        template <typename T>
+        struct HeapCell
+        {
+            std::atomic<uint32_t> refcount;
+            T object;
+
+            template <typename... Args>
+            explicit HeapCell(Args&&... args) :
+                refcount(1), object(std::forward<Args>(args)...)
+            {}
+        };
+
+        /**
+         * @brief Reference counted string, shared by the values holding it and copied before being modified
+         * @details The strings of the constants table are interned by the State: they are all different,
+         *          thus two interned strings are equal only if they are stored in the same cell.
+         */
+        struct StringCell
+        {
+            std::atomic<uint32_t> refcount;
+            bool interned;
+            std::string object;
+
+            explicit StringCell(std::string str) :
+                refcount(1), interned(false), object(std::move(str))
+            {}
+        };
+    }
+
     class ARK_API Value
     {
     public:
         using ProcType = Value (*)(std::vector<Value>&, VM*);
         using Iterator = std::vector<Value>::iterator;
 
-        using Value_t = std::variant<
-            double,                //  8 bytes
-            std::string,           // 32 bytes
-            internal::PageAddr_t,  //  2 bytes
-            ProcType,              //  8 bytes
-            internal::Closure,     // 24 bytes
-            UserType,              // 24 bytes
-            std::vector<Value>,    // 24 bytes
-            Value*                 //  8 bytes
-            >;                     // +8 bytes overhead
-        //                      total 40 bytes
+        /**
+         * @brief Storage of a value, on 8 bytes
+         * @details Numbers, page addresses, procedures and references are stored inline,
+         *          while strings, lists, closures and user types are in reference counted heap
+         *          cells. Strings and lists are copied on write, when they are modified while
+         *          being shared.
+         *          With the type tag, a Value is 16 bytes.
+         */
+        union Payload
+        {
+            double number;
+            internal::PageAddr_t page_addr;
+            ProcType proc;
+            Value* reference;
+            internal::StringCell* string;
+            internal::HeapCell<std::vector<Value>>* list;
+            internal::HeapCell<internal::Closure>* closure;
+            internal::HeapCell<UserType>* user;
+        };
 
         /**
          * @brief Construct a new Value object
@@ -98,12 +145,15 @@ namespace Ark
          */
         template <typename T>
         Value(const ValueType type, T&& value) noexcept :
-            m_type(type), m_value(value)
-        {}
+            Value(std::remove_cvref_t<T>(std::forward<T>(value)))
+        {
+            m_type = type;
+        }
 
         explicit Value(int value) noexcept;
         explicit Value(double value) noexcept;
         explicit Value(const std::string& value) noexcept;
+        explicit Value(std::string&& value) noexcept;
         explicit Value(internal::PageAddr_t value) noexcept;
         explicit Value(ProcType value) noexcept;
         explicit Value(std::vector<Value>&& value) noexcept;
@@ -111,6 +161,56 @@ namespace Ark
         explicit Value(UserType&& value) noexcept;
         explicit Value(Value* ref) noexcept;
 
+        Value(const Value& other) noexcept :
+            m_type(other.m_type), m_payload(other.m_payload)
+        {
+            if (isHeapAllocated())
+                copyHeapObject(other);
+        }
+
+        Value(Value&& other) noexcept :
+            m_type(other.m_type), m_payload(other.m_payload)
+        {
+            if (isHeapAllocated())
+                other.m_type = ValueType::Undefined;
+        }
+
+        Value& operator=(const Value& other) noexcept
+        {
+            if (!isHeapAllocated() && !other.isHeapAllocated())
+            {
+                m_type = other.m_type;
+                m_payload = other.m_payload;
+            }
+            else if (this != &other)
+                // copy first, `other` could be owned by this value
+                *this = Value(other);
+            return *this;
+        }
+
+        Value& operator=(Value&& other) noexcept
+        {
+            if (this != &other) [[likely]]
+            {
+                const ValueType type = other.m_type;
+                const Payload payload = other.m_payload;
+                if (other.isHeapAllocated())
+                    other.m_type = ValueType::Undefined;
+
+                if (isHeapAllocated())
+                    releaseHeapObject();
+                m_type = type;
+                m_payload = payload;
+            }
+            return *this;
+        }
+
+        ~Value()
+        {
+            if (isHeapAllocated())
+                releaseHeapObject();
+        }
+
         [[nodiscard]] ValueType valueType() const noexcept { return m_type; }
         [[nodiscard]] bool isFunction() const noexcept
         {
@@ -119,14 +219,39 @@ namespace Ark
                 (type == ValueType::Reference && reference()->isFunction());
         }
 
-        [[nodiscard]] double number() const { return std::get<double>(m_value); }
-        [[nodiscard]] const std::string& string() const { return std::get<std::string>(m_value); }
-        [[nodiscard]] const std::vector<Value>& constList() const { return std::get<std::vector<Value>>(m_value); }
-        [[nodiscard]] const UserType& usertype() const { return std::get<UserType>(m_value); }
-        [[nodiscard]] std::vector<Value>& list() { return std::get<std::vector<Value>>(m_value); }
-        [[nodiscard]] std::string& stringRef() { return std::get<std::string>(m_value); }
-        [[nodiscard]] UserType& usertypeRef() { return std::get<UserType>(m_value); }
-        [[nodiscard]] Value* reference() const { return std::get<Value*>(m_value); }
+        [[nodiscard]] double number() const { return m_payload.number; }
+        [[nodiscard]] const std::string& string() const { return m_payload.string->object; }
+        [[nodiscard]] const std::vector<Value>& constList() const { return m_payload.list->object; }
+        [[nodiscard]] const UserType& usertype() const { return m_payload.user->object; }
+
+        /**
+         * @brief Get the list held by the value, to modify it
+         * @details If the list is shared with other values, it is copied first
+         *
+         * @return std::vector<Value>&
+         */
+        [[nodiscard]] std::vector<Value>& list()
+        {
+            if (m_payload.list->refcount.load(std::memory_order_acquire) != 1) [[unlikely]]
+                detachList();
+            return m_payload.list->object;
+        }
+
+        /**
+         * @brief Get the string held by the value, to modify it
+         * @details If the string is shared with other values or interned, it is copied first
+         *
+         * @return std::string&
+         */
+        [[nodiscard]] std::string& stringRef()
+        {
+            if (m_payload.string->refcount.load(std::memory_order_acquire) != 1 || m_payload.string->interned) [[unlikely]]
+                detachString();
+            return m_payload.string->object;
+        }
+
+        [[nodiscard]] UserType& usertypeRef() { return m_payload.user->object; }
+        [[nodiscard]] Value* reference() const { return m_payload.reference; }
 
         /**
          * @brief Add an element to the list held by the value (if the value type is set to list)
@@ -149,18 +274,58 @@ namespace Ark
         friend ARK_API_INLINE bool operator!(const Value& A) noexcept;
 
         friend class Ark::VM;
+        friend class Ark::State;
         friend class Ark::BytecodeReader;
 
     private:
         ValueType m_type;
-        Value_t m_value;
+        Payload m_payload;
 
         [[nodiscard]] constexpr uint8_t typeNum() const noexcept { return static_cast<uint8_t>(m_type); }
 
-        [[nodiscard]] internal::PageAddr_t pageAddr() const { return std::get<internal::PageAddr_t>(m_value); }
-        [[nodiscard]] const ProcType& proc() const { return std::get<ProcType>(m_value); }
-        [[nodiscard]] const internal::Closure& closure() const { return std::get<internal::Closure>(m_value); }
-        [[nodiscard]] internal::Closure& refClosure() { return std::get<internal::Closure>(m_value); }
+        /**
+         * @brief Check if the payload points to an object owned by the value (string, list, closure or user type)
+         *
+         * @return true if the destructor/copy constructor need to manage a heap object
+         */
+        [[nodiscard]] constexpr bool isHeapAllocated() const noexcept
+        {
+            constexpr unsigned mask = (1u << static_cast<uint8_t>(ValueType::List)) |
+                (1u << static_cast<uint8_t>(ValueType::String)) |
+                (1u << static_cast<uint8_t>(ValueType::Closure)) |
+                (1u << static_cast<uint8_t>(ValueType::User));
+            return typeNum() < 32 && ((1u << typeNum()) & mask) != 0;
+        }
+
+        /**
+         * @brief Share the reference counted heap object of another value whose payload has already been copied
+         *
+         * @param other
+         */
+        void copyHeapObject(const Value& other) noexcept;
+
+        /**
+         * @brief Destroy the heap object (or decrement its reference count) held by the value
+         *
+         */
+        void releaseHeapObject() noexcept;
+
+        /**
+         * @brief Replace the shared list held by the value by a copy of it, that only this value owns
+         *
+         */
+        void detachList();
+
+        /**
+         * @brief Replace the shared string held by the value by a copy of it, that only this value owns
+         *
+         */
+        void detachString();
+
+        [[nodiscard]] internal::PageAddr_t pageAddr() const { return m_payload.page_addr; }
+        [[nodiscard]] const ProcType& proc() const { return m_payload.proc; }
+        [[nodiscard]] const internal::Closure& closure() const { return m_payload.closure->object; }
+        [[nodiscard]] internal::Closure& refClosure() { return m_payload.closure->object; }
     };
 
     inline bool operator==(const Value& A, const Value& B) noexcept
@@ -172,14 +337,58 @@ namespace Ark
         if (A.typeNum() >= static_cast<uint8_t>(ValueType::Nil))
             return true;
 
-        return A.m_value == B.m_value;
+        switch (A.m_type)
+        {
+            case ValueType::List:
+                return A.constList() == B.constList();
+            case ValueType::Number:
+                return A.number() == B.number();
+            case ValueType::String:
+                if (A.m_payload.string == B.m_payload.string)
+                    return true;
+                if (A.m_payload.string->interned && B.m_payload.string->interned)
+                    return false;
+                return A.string() == B.string();
+            case ValueType::PageAddr:
+                return A.pageAddr() == B.pageAddr();
+            case ValueType::CProc:
+                return A.proc() == B.proc();
+            case ValueType::Closure:
+                return A.closure() == B.closure();
+            case ValueType::User:
+                return A.usertype() == B.usertype();
+            default:
+                return false;
+        }
     }
 
     inline bool operator<(const Value& A, const Value& B) noexcept
     {
         if (A.m_type != B.m_type)
             return (A.typeNum() - B.typeNum()) < 0;
-        return A.m_value < B.m_value;
+
+        switch (A.m_type)
+        {
+            case ValueType::List:
+                return A.constList() < B.constList();
+            case ValueType::Number:
+                return A.number() < B.number();
+            case ValueType::String:
+                return A.string() < B.string();
+            case ValueType::PageAddr:
+            case ValueType::InstPtr:
+                return A.pageAddr() < B.pageAddr();
+            case ValueType::CProc:
+                return std::less<Value::ProcType> {}(A.proc(), B.proc());
+            case ValueType::Closure:
+                return A.closure() < B.closure();
+            case ValueType::User:
+                return A.usertype() < B.usertype();
+            case ValueType::Reference:
+                return std::less<const Value*> {}(A.reference(), B.reference());
+            default:
+                return false;
+        }
     }
 
     inline bool operator!=(const Value& A, const Value& B) noexcept
@@ -12,7 +12,7 @@ namespace Ark::internal::Builtins::Async
     /**
      * @name async
      * @brief Calls a function asynchronously with a given set of arguments
-     * @details The function is started in a separate context, with no access to the others, preventing any concurrency problems.
+     * @details The function is started in a separate context, with no access to the others, preventing any concurrency problems. It is run by a pool of threads owned by the VM.
      * @param func the function to call
      * @param args... the arguments of the function
      * =begin
@@ -34,7 +34,7 @@ namespace Ark::internal::Builtins::Async
     /**
      * @name await
      * @brief Blocks until the result becomes available
-     * @details
+     * @details While waiting, the current thread runs the pending futures. A future can only be awaited once, awaiting it again gives nil.
      * @param future the future to wait for its result to be available
      * =begin
      * (let foo (fun (a b) (+ a b)))
@@ -53,4 +53,74 @@ namespace Ark::internal::Builtins::Async
 
         return res;
     }
+
+    /**
+     * @name spawn
+     * @brief Starts a coroutine calling a function with a given set of arguments
+     * @details The coroutine runs in a separate context, like a function called with async, but it can be suspended
+     * with yield and join without blocking a thread: a lot of coroutines can run concurrently on a few threads.
+     * @param func the function to call
+     * @param args... the arguments of the function
+     * =begin
+     * (let foo (fun (a b) (+ a b)))
+     * (spawn foo 1 2)
+     * =end
+     * @author https://github.com/SuperFola
+     */
+    Value spawn(std::vector<Value>& n, VM* vm)
+    {
+        if (n.empty() || (n[0].valueType() != ValueType::PageAddr && n[0].valueType() != ValueType::CProc && n[0].valueType() != ValueType::Closure))
+            types::generateError(
+                "spawn", { { types::Contract { { types::Typedef("function", { ValueType::PageAddr, ValueType::CProc, ValueType::Closure }), types::Typedef("args", ValueType::Any, /* is_variadic= */ true) } }, types::Contract { { types::Typedef("function", { ValueType::PageAddr, ValueType::CProc, ValueType::Closure }) } } } }, n);
+
+        Coroutine* coroutine = vm->createCoroutine(n);
+        return Value(UserType(coroutine));
+    }
+
+    /**
+     * @name yield
+     * @brief Suspends the current coroutine, to let the other ones run
+     * @details The coroutine is resumed later on, by any thread. Does nothing outside of a coroutine.
+     * =begin
+     * (let count (fun (n) {
+     *     (mut i 0)
+     *     (while (< i n) {
+     *         (print i)
+     *         (yield)
+     *         (set i (+ 1 i)) })}))
+     * (spawn count 10)
+     * =end
+     * @author https://github.com/SuperFola
+     */
+    Value yield(std::vector<Value>& n [[maybe_unused]], VM* vm [[maybe_unused]])
+    {
+        if (Coroutine* coroutine = Coroutine::current(); coroutine != nullptr)
+            coroutine->yield();
+        return nil;
+    }
+
+    /**
+     * @name join
+     * @brief Waits for a coroutine to finish and returns its result
+     * @details Inside a coroutine, the current coroutine is suspended until the other one finishes. Otherwise, the
+     * current thread runs the pending coroutines while waiting. A coroutine can be joined multiple times.
+     * @param coroutine the coroutine to wait for
+     * =begin
+     * (let foo (fun (a b) (+ a b)))
+     * (let co (spawn foo 1 2))
+     * (print (join co))  # 3
+     * =end
+     * @author https://github.com/SuperFola
+     */
+    Value join(std::vector<Value>& n, VM* vm [[maybe_unused]])
+    {
+        if (!types::check(n, ValueType::User) || !n[0].usertypeRef().is<Coroutine>())
+            types::generateError("join", { { types::Contract { { types::Typedef("coroutine", ValueType::User) } } } }, n);
+
+        auto& coroutine = n[0].usertypeRef().as<Coroutine>();
+        if (&coroutine == Coroutine::current())
+            throw std::runtime_error("join: a coroutine can not wait for itself");
+
+        return coroutine.join();
+    }
 }
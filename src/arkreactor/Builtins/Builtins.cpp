@@ -32,6 +32,9 @@ namespace Ark::internal::Builtins
         { "list:sort", Value(List::sort_) },
         { "list:fill", Value(List::fill) },
         { "list:setAt", Value(List::setListAt) },
+        { "list:parallelMap", Value(List::parallelMap) },
+        { "list:parallelFilter", Value(List::parallelFilter) },
+        { "list:parallelReduce", Value(List::parallelReduce) },
 
         // IO
         { "print", Value(IO::print) },
@@ -89,6 +92,9 @@ namespace Ark::internal::Builtins
 
         // Async
         { "async", Value(Async::async) },
-        { "await", Value(Async::await) }
+        { "await", Value(Async::await) },
+        { "spawn", Value(Async::spawn) },
+        { "yield", Value(Async::yield) },
+        { "join", Value(Async::join) }
     };
 }
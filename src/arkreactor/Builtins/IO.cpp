@@ -92,7 +92,7 @@ namespace Ark::internal::Builtins::IO
                 f.close();
             }
             else
-                throw std::runtime_error(fmt::format("io:writeFile: couldn't write to file \"{}\"", n[0].stringRef()));
+                throw std::runtime_error(fmt::format("io:writeFile: couldn't write to file \"{}\"", n[0].string()));
         }
         else
             types::generateError(
@@ -124,7 +124,7 @@ namespace Ark::internal::Builtins::IO
                 f.close();
             }
             else
-                throw std::runtime_error(fmt::format("io:appendToFile: couldn't write to file \"{}\"", n[0].stringRef()));
+                throw std::runtime_error(fmt::format("io:appendToFile: couldn't write to file \"{}\"", n[0].string()));
         }
         else
             types::generateError(
@@ -2,6 +2,7 @@
 
 #include <utility>
 #include <algorithm>
+#include <mutex>
 #include <fmt/core.h>
 
 #include <Ark/TypeChecker.hpp>
@@ -51,11 +52,11 @@ namespace Ark::internal::Builtins::List
                 { { types::Contract { { types::Typedef("list", ValueType::List), types::Typedef("value", ValueType::Any) } } } },
                 n);
 
-        std::vector<Value>& l = n[0].list();
+        const std::vector<Value>& l = n[0].constList();
         for (auto it = l.begin(), it_end = l.end(); it != it_end; ++it)
         {
             if (*it == n[1])  // FIXME cast
-                return Value(static_cast<int>(std::distance<Value::Iterator>(l.begin(), it)));
+                return Value(static_cast<int>(std::distance(l.begin(), it)));
         }
 
         return Value(-1);
@@ -96,12 +97,12 @@ namespace Ark::internal::Builtins::List
             throw std::runtime_error(fmt::format("list:slice: start position ({}) must be less or equal to the end position ({})", start, end));
         if (start < 0)
             throw std::runtime_error(fmt::format("list:slice: start index {} can not be less than 0", start));
-        if (std::cmp_greater(end, n[0].list().size()))
-            throw std::runtime_error(fmt::format("list:slice: end index {} out of range (length: {})", end, n[0].list().size()));
+        if (std::cmp_greater(end, n[0].constList().size()))
+            throw std::runtime_error(fmt::format("list:slice: end index {} out of range (length: {})", end, n[0].constList().size()));
 
         std::vector<Value> list;
         for (auto i = static_cast<std::size_t>(start); std::cmp_less(i, end); i += static_cast<std::size_t>(step))
-            list.push_back(n[0].list()[i]);
+            list.push_back(n[0].constList()[i]);
 
         return Value(std::move(list));
     }
@@ -180,4 +181,143 @@ namespace Ark::internal::Builtins::List
         n[0].list()[static_cast<std::size_t>(n[1].number())] = n[2];
         return n[0];
     }
+
+    namespace
+    {
+        bool checkParallelArgs(const std::vector<Value>& n)
+        {
+            return n.size() == 2 && n[0].valueType() == ValueType::List &&
+                (n[1].valueType() == ValueType::PageAddr || n[1].valueType() == ValueType::CProc || n[1].valueType() == ValueType::Closure);
+        }
+
+        void parallelArgsError(const std::string& funcname, const std::vector<Value>& n)
+        {
+            types::generateError(
+                funcname,
+                { { types::Contract { { types::Typedef("list", ValueType::List),
+                                        types::Typedef("func", { ValueType::PageAddr, ValueType::CProc, ValueType::Closure }) } } } },
+                n);
+        }
+    }
+
+    /**
+     * @name list:parallelMap
+     * @brief Call a function on each element of a list, using the threads running the futures
+     * @details The list is split in chunks, each one being processed in a separate context like a function called with async. The results are in the same order as the elements. The original list is not modified
+     * @param list the list to transform
+     * @param func the function to call on each element
+     * =begin
+     * (list:parallelMap [1 2 3] (fun (x) (* x x)))  # [1 4 9]
+     * =end
+     * @author https://github.com/SuperFola
+     */
+    Value parallelMap(std::vector<Value>& n, VM* vm)
+    {
+        if (!checkParallelArgs(n))
+            parallelArgsError("list:parallelMap", n);
+
+        const std::vector<Value>& list = n[0].constList();
+        std::vector<Value> output(list.size());
+
+        vm->parallelFor(list.size(), [&](ExecutionContext& context, const std::size_t begin, const std::size_t end) {
+            std::vector<Value> args { n[1], nil };
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                args[1] = list[i];
+                output[i] = vm->resolve(&context, args);
+            }
+        });
+
+        return Value(std::move(output));
+    }
+
+    /**
+     * @name list:parallelFilter
+     * @brief Keep the elements of a list for which a function returns a truthy value, using the threads running the futures
+     * @details The list is split in chunks, each one being processed in a separate context like a function called with async. The elements kept are in the same order as in the original list, which is not modified
+     * @param list the list to filter
+     * @param func the predicate to call on each element
+     * =begin
+     * (list:parallelFilter [1 2 3 4] (fun (x) (= 0 (mod x 2))))  # [2 4]
+     * =end
+     * @author https://github.com/SuperFola
+     */
+    Value parallelFilter(std::vector<Value>& n, VM* vm)
+    {
+        if (!checkParallelArgs(n))
+            parallelArgsError("list:parallelFilter", n);
+
+        const std::vector<Value>& list = n[0].constList();
+        std::vector<uint8_t> keep(list.size(), 0);
+
+        vm->parallelFor(list.size(), [&](ExecutionContext& context, const std::size_t begin, const std::size_t end) {
+            std::vector<Value> args { n[1], nil };
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                args[1] = list[i];
+                keep[i] = !!vm->resolve(&context, args);
+            }
+        });
+
+        std::vector<Value> output;
+        for (std::size_t i = 0, end = list.size(); i < end; ++i)
+        {
+            if (keep[i] != 0)
+                output.push_back(list[i]);
+        }
+        return Value(std::move(output));
+    }
+
+    /**
+     * @name list:parallelReduce
+     * @brief Combine the elements of a list two by two with a function, using the threads running the futures
+     * @details The list is split in chunks reduced in separate contexts like functions called with async, then their results are combined in order. The function must be associative. Returns nil if the list is empty
+     * @param list the list to reduce
+     * @param func the function taking two values and combining them
+     * =begin
+     * (list:parallelReduce [1 2 3 4] (fun (a b) (+ a b)))  # 10
+     * =end
+     * @author https://github.com/SuperFola
+     */
+    Value parallelReduce(std::vector<Value>& n, VM* vm)
+    {
+        if (!checkParallelArgs(n))
+            parallelArgsError("list:parallelReduce", n);
+
+        const std::vector<Value>& list = n[0].constList();
+        if (list.empty())
+            return nil;
+
+        // result of each chunk, by index of its first element
+        std::mutex mutex;
+        std::vector<std::pair<std::size_t, Value>> partials;
+
+        vm->parallelFor(list.size(), [&](ExecutionContext& context, const std::size_t begin, const std::size_t end) {
+            std::vector<Value> args { n[1], list[begin], nil };
+            for (std::size_t i = begin + 1; i < end; ++i)
+            {
+                args[2] = list[i];
+                args[1] = vm->resolve(&context, args);
+            }
+
+            const std::lock_guard lock(mutex);
+            partials.emplace_back(begin, args[1]);
+        });
+
+        std::ranges::sort(partials, {}, &std::pair<std::size_t, Value>::first);
+
+        // the partial results are combined in order, in a context of their own
+        Value output = partials.front().second;
+        vm->parallelFor(1, [&](ExecutionContext& context, std::size_t, std::size_t) {
+            std::vector<Value> args { n[1], output, nil };
+            for (auto it = partials.begin() + 1, it_end = partials.end(); it != it_end; ++it)
+            {
+                args[2] = it->second;
+                args[1] = vm->resolve(&context, args);
+            }
+            output = args[1];
+        });
+
+        return output;
+    }
 }
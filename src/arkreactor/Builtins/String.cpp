@@ -40,7 +40,7 @@ namespace Ark::internal::Builtins::String
         for (auto it = n.begin() + 1, it_end = n.end(); it != it_end; ++it)
         {
             if (it->valueType() == ValueType::String)
-                store.push_back(it->stringRef());
+                store.push_back(it->string());
             else if (it->valueType() == ValueType::Number)
                 store.push_back(it->number());
             else if (it->valueType() == ValueType::Nil)
@@ -55,13 +55,13 @@ namespace Ark::internal::Builtins::String
 
         try
         {
-            return Value(fmt::vformat(n[0].stringRef(), store));
+            return Value(fmt::vformat(n[0].string(), store));
         }
         catch (fmt::format_error& e)
         {
             throw std::runtime_error(
                 fmt::format("str:format: can not format \"{}\" ({} argument{} provided) because of {}",
-                            n[0].stringRef(),
+                            n[0].string(),
                             n.size() - 1,
                             // if we have more than one argument (not counting the string to format), plural form
                             n.size() > 2 ? "s" : "",
@@ -89,7 +89,7 @@ namespace Ark::internal::Builtins::String
                 { { types::Contract { { types::Typedef("string", ValueType::String), types::Typedef("substr", ValueType::String) } } } },
                 n);
 
-        std::size_t index = n[0].stringRef().find(n[1].stringRef());
+        std::size_t index = n[0].string().find(n[1].string());
         if (index != std::string::npos)
             return Value(static_cast<int>(index));
         return Value(-1);
@@ -116,8 +116,8 @@ namespace Ark::internal::Builtins::String
                 n);
 
         long id = static_cast<long>(n[1].number());
-        if (id < 0 || std::cmp_greater_equal(id, n[0].stringRef().size()))
-            throw std::runtime_error(fmt::format("str:removeAt: index {} out of range (length: {})", id, n[0].stringRef().size()));
+        if (id < 0 || std::cmp_greater_equal(id, n[0].string().size()))
+            throw std::runtime_error(fmt::format("str:removeAt: index {} out of range (length: {})", id, n[0].string().size()));
 
         n[0].stringRef().erase(static_cast<std::size_t>(id), 1);
         return n[0];
@@ -141,7 +141,7 @@ namespace Ark::internal::Builtins::String
                 { { types::Contract { { types::Typedef("string", ValueType::String) } } } },
                 n);
 
-        return Value(utf8::codepoint(n[0].stringRef().c_str()));
+        return Value(utf8::codepoint(n[0].string().c_str()));
     }
 
     /**
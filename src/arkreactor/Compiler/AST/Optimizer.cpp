@@ -1,7 +1,173 @@
 #include <Ark/Compiler/AST/Optimizer.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <fmt/core.h>
+
 namespace Ark::internal
 {
+    namespace
+    {
+        /**
+         * @brief Get the value the VM will load for a number
+         * @details The numbers are written in the bytecode with std::to_string, thus with 6 decimals
+         *
+         * @param number
+         * @return double
+         */
+        double loadedNumber(const double number)
+        {
+            return std::stod(std::to_string(number));
+        }
+
+        /**
+         * @brief Check if a number computed at compile time can replace the computation made by the VM
+         *
+         * @param number
+         * @return true if the number is written in the bytecode without loss
+         */
+        bool isExactConstant(const double number)
+        {
+            // a negative zero could share the constant of a positive one
+            return loadedNumber(number) == number && !(number == 0 && std::signbit(number));
+        }
+
+        /// Maximum number of nodes in the body of an inlined function
+        constexpr std::size_t MaxInlinedNodes = 16;
+
+        /**
+         * @brief Check if a symbol is an operator or a list instruction, which is compiled to an instruction instead of a call
+         *
+         * @param name
+         * @return true if the symbol is an operator or a list instruction
+         */
+        bool isInstruction(const std::string& name)
+        {
+            return std::ranges::find(Language::operators, name) != Language::operators.end() ||
+                std::ranges::find(Language::listInstructions, name) != Language::listInstructions.end() ||
+                name == Language::And || name == Language::Or;
+        }
+
+        /**
+         * @brief Check if computing an expression can call a function written in ArkScript, which could modify any variable
+         *
+         * @param node
+         * @return true if the expression calls something which isn't an operator or a list instruction
+         */
+        bool mayRunUserCode(const Node& node)
+        {
+            if (node.nodeType() != NodeType::List || node.constList().empty())
+                return false;
+
+            // a call on a field (method) or on a computed value runs user code as well
+            const Node& first = node.constList()[0];
+            if (first.nodeType() != NodeType::Keyword && (first.nodeType() != NodeType::Symbol || !isInstruction(first.string())))
+                return true;
+            return std::ranges::any_of(node.constList(), mayRunUserCode);
+        }
+
+        /**
+         * @brief Approximate the number of instructions the compiler generates for an expression
+         *
+         * @param node
+         * @return std::size_t
+         */
+        std::size_t instructionsCount(const Node& node)
+        {
+            if (node.nodeType() == NodeType::Field)
+                return node.constList().size();
+            if (node.nodeType() != NodeType::List)
+                return 1;
+
+            std::size_t count = 1;
+            for (auto it = node.constList().begin() + 1, end = node.constList().end(); it != end; ++it)
+                count += instructionsCount(*it);
+            return count;
+        }
+
+        /**
+         * @brief Check if a symbol is an operator computing a value without side effect
+         *
+         * @param name
+         * @return true if the symbol is an operator other than assert
+         */
+        bool isPureOperator(const std::string& name)
+        {
+            return name != "assert" && std::ranges::find(Language::operators, name) != Language::operators.end();
+        }
+
+        /**
+         * @brief Check if an expression can not throw, whatever the values of its variables
+         *
+         * @param node
+         * @return true if the node is a literal, a symbol, or a comparison, not or nil? of such nodes
+         */
+        bool cannotThrow(const Node& node)
+        {
+            if (node.nodeType() != NodeType::List)
+                return node.nodeType() != NodeType::Field;
+            if (node.constList().empty() || node.constList()[0].nodeType() != NodeType::Symbol)
+                return false;
+
+            // the comparisons are defined between values of any types
+            constexpr std::array<std::string_view, 8> total_operators = { ">", "<", "<=", ">=", "!=", "=", "nil?", "not" };
+            const std::string& name = node.constList()[0].string();
+            return std::ranges::find(total_operators, name) != total_operators.end() &&
+                std::all_of(node.constList().begin() + 1, node.constList().end(), cannotThrow);
+        }
+
+        /**
+         * @brief Replace the arguments of a function by their values in a copy of its body
+         *
+         * @param node copy of the body of the function
+         * @param arguments names of the arguments of the function
+         * @param values values given to the function
+         * @param is_called true if the node is the function of a call
+         * @return true if the arguments could be replaced
+         */
+        bool replaceArguments(Node& node, const std::vector<Node>& arguments, const std::vector<Node>& values, const bool is_called)
+        {
+            if (node.nodeType() == NodeType::Symbol)
+            {
+                for (std::size_t i = 0, end = arguments.size(); i < end; ++i)
+                {
+                    if (arguments[i].string() == node.string())
+                    {
+                        // calling a literal must still fail at runtime, not at compile time
+                        if (is_called && values[i].nodeType() != NodeType::Symbol)
+                            return false;
+                        node = values[i];
+                        return true;
+                    }
+                }
+                return true;
+            }
+            if (node.nodeType() == NodeType::List)
+            {
+                for (std::size_t i = 0, end = node.constList().size(); i < end; ++i)
+                {
+                    if (!replaceArguments(node.list()[i], arguments, values, i == 0))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Check if a node is a literal value: a number, a string, or one of the builtin constants which can not be redefined
+         *
+         * @param node
+         * @return true if the node is a literal
+         */
+        bool isLiteral(const Node& node)
+        {
+            if (node.nodeType() == NodeType::Symbol)
+                return node.string() == "true" || node.string() == "false" || node.string() == "nil";
+            return node.nodeType() == NodeType::Number || node.nodeType() == NodeType::String;
+        }
+    }
+
     Optimizer::Optimizer(const unsigned debug) noexcept :
         Pass("Optimizer", debug), m_ast()
     {}
@@ -9,7 +175,19 @@ namespace Ark::internal
     void Optimizer::process(const Node& ast)
     {
         m_ast = ast;
-        // FIXME activate this removeUnused();
+
+        m_sym_bindings.clear();
+        m_sym_mutations.clear();
+        m_global_constants.clear();
+        m_inline_functions.clear();
+        if (m_ast.nodeType() == NodeType::List)
+        {
+            countBindings(m_ast);
+            countOccurences(m_ast);
+            foldBlock(m_ast, nullptr);
+            removeUnused();
+            hoistLoopInvariants(m_ast, /* is_local= */ false);
+        }
     }
 
     const Node& Optimizer::ast() const noexcept
@@ -24,68 +202,816 @@ namespace Ark::internal
 
     void Optimizer::removeUnused()
     {
-        // do not handle non-list nodes
-        if (m_ast.nodeType() != NodeType::List)
-            return;
+        // removing code can make other bindings unused, eg the ones used only in an unreachable branch
+        bool changed = true;
+        while (changed)
+        {
+            m_sym_appearances.clear();
+            countOccurences(m_ast);
+            changed = removeDeadCode(m_ast, /* is_result_unused= */ false, /* is_local= */ false);
+        }
+    }
 
-        runOnGlobalScopeVars(m_ast, [this](const Node& node, Node& parent [[maybe_unused]], int idx [[maybe_unused]]) {
-            m_sym_appearances[node.constList()[1].string()] = 0;
-        });
-        countOccurences(m_ast);
+    void Optimizer::countOccurences(const Node& node)
+    {
+        if (node.nodeType() == NodeType::Symbol || node.nodeType() == NodeType::Capture)
+            m_sym_appearances[node.string()]++;
+        else if (node.nodeType() == NodeType::Field)
+        {
+            for (const auto& child : node.constList())
+                countOccurences(child);
+        }
+        else if (node.nodeType() == NodeType::List && !node.constList().empty())
+        {
+            const std::vector<Node>& list = node.constList();
+            std::size_t i = 0;
+            if (list[0].nodeType() == NodeType::Keyword)
+            {
+                const Keyword kw = list[0].keyword();
+                // the symbol defined isn't a read of the symbol
+                if (kw == Keyword::Let || kw == Keyword::Mut)
+                    i = 2;
+                else if (kw == Keyword::Fun && list.size() > 1 && list[1].nodeType() == NodeType::List)
+                {
+                    for (const auto& arg : list[1].constList())
+                    {
+                        if (arg.nodeType() == NodeType::Capture)
+                            countOccurences(arg);
+                    }
+                    i = 2;
+                }
+            }
+
+            for (const std::size_t end = list.size(); i < end; ++i)
+                countOccurences(list[i]);
+        }
+    }
+
+    bool Optimizer::removeDeadCode(Node& node, const bool is_result_unused, const bool is_local)
+    {
+        if (node.nodeType() != NodeType::List || node.constList().empty())
+            return false;
+
+        std::vector<Node>& list = node.list();
+        bool changed = false;
+
+        if (list[0].nodeType() != NodeType::Keyword)
+        {
+            for (auto& child : list)
+                changed = removeDeadCode(child, /* is_result_unused= */ false, is_local) || changed;
+            return changed;
+        }
 
-        // logic: remove piece of code with only 1 reference, if they aren't function calls
-        runOnGlobalScopeVars(m_ast, [this](const Node& node, Node& parent, const std::size_t idx) {
-            std::string name = node.constList()[1].string();
-            // a variable was only declared and never used
-            if (m_sym_appearances.contains(name) && m_sym_appearances[name] == 1 && parent.list()[idx].list()[2].nodeType() != NodeType::List)
+        // an empty block generates no code
+        const auto remove_node = [&node]() {
+            Node empty(NodeType::List);
+            empty.push_back(Node(Keyword::Begin));
+            empty.setFilename(node.filename());
+            empty.setPos(node.line(), node.col());
+            node = empty;
+            return true;
+        };
+
+        switch (list[0].keyword())
+        {
+            case Keyword::Begin:
             {
-                m_logger.debug("Removing unused variable '{}'", name);
-                // erase the node from the list
-                parent.list().erase(parent.list().begin() + static_cast<std::vector<Node>::difference_type>(idx));
+                if (list.size() == 1)
+                    break;
+
+                for (std::size_t i = 1, size = list.size(); i < size; ++i)
+                    changed = removeDeadCode(list[i], (i != size - 1) || is_result_unused, is_local) || changed;
+
+                // the last node gives its value to the block, unless it is dropped
+                const auto last = is_result_unused ? list.end() : list.end() - 1;
+                const auto first_removed = std::remove_if(list.begin() + 1, last, [](const Node& child) {
+                    const bool is_empty_block = child.nodeType() == NodeType::List && child.constList().size() == 1 &&
+                        child.constList()[0].nodeType() == NodeType::Keyword && child.constList()[0].keyword() == Keyword::Begin;
+                    // the other pure nodes make the compiler emit a warning about the useless statement
+                    return is_empty_block || child.nodeType() == NodeType::Number || child.nodeType() == NodeType::String;
+                });
+                if (first_removed != last)
+                {
+                    list.erase(first_removed, last);
+                    changed = true;
+                }
+                break;
             }
-        });
+
+            case Keyword::If:
+                if (list.size() < 3)
+                    break;
+
+                changed = removeDeadCode(list[1], /* is_result_unused= */ false, is_local);
+                for (std::size_t i = 2, size = list.size(); i < size; ++i)
+                    changed = removeDeadCode(list[i], is_result_unused, is_local) || changed;
+
+                if (const std::optional<bool> condition = constantCondition(list[1]); condition.has_value())
+                {
+                    if (condition.value())
+                    {
+                        m_logger.debug("Removing unreachable else branch at {}:{}", node.filename(), node.line());
+                        node = Node(list[2]);
+                        changed = true;
+                    }
+                    else if (list.size() == 4)
+                    {
+                        m_logger.debug("Removing unreachable then branch at {}:{}", node.filename(), node.line());
+                        node = Node(list[3]);
+                        changed = true;
+                    }
+                    // without an else branch, the if doesn't push a value when its condition is false
+                    else if (is_result_unused)
+                    {
+                        m_logger.debug("Removing unreachable branch at {}:{}", node.filename(), node.line());
+                        changed = remove_node();
+                    }
+                }
+                break;
+
+            case Keyword::While:
+                if (list.size() != 3)
+                    break;
+
+                if (const std::optional<bool> condition = constantCondition(list[1]); condition.has_value() && !condition.value())
+                {
+                    m_logger.debug("Removing unreachable loop at {}:{}", node.filename(), node.line());
+                    changed = remove_node();
+                }
+                else
+                {
+                    changed = removeDeadCode(list[1], /* is_result_unused= */ false, is_local);
+                    changed = removeDeadCode(list[2], /* is_result_unused= */ true, is_local) || changed;
+                }
+                break;
+
+            case Keyword::Fun:
+                if (list.size() == 3)
+                    changed = removeDeadCode(list[2], /* is_result_unused= */ false, /* is_local= */ true);
+                break;
+
+            case Keyword::Let:
+            case Keyword::Mut:
+                if (list.size() != 3)
+                    break;
+
+                // a global variable can be used by the host program, only the local ones are removed
+                if (is_local && is_result_unused && list[1].nodeType() == NodeType::Symbol &&
+                    !m_sym_appearances.contains(list[1].string()) && isPure(list[2]))
+                {
+                    m_logger.debug("Removing unused variable '{}'", list[1].string());
+                    changed = remove_node();
+                }
+                else
+                    changed = removeDeadCode(list[2], /* is_result_unused= */ false, is_local);
+                break;
+
+            case Keyword::Set:
+                if (list.size() == 3)
+                    changed = removeDeadCode(list[2], /* is_result_unused= */ false, is_local);
+                break;
+
+            default:
+                break;
+        }
+
+        return changed;
+    }
+
+    std::optional<bool> Optimizer::constantCondition(const Node& node)
+    {
+        // same truthiness as the VM values
+        if (node.nodeType() == NodeType::Number)
+            return loadedNumber(node.number()) != 0.0;
+        if (node.nodeType() == NodeType::String)
+            return !node.string().empty();
+        if (node.nodeType() == NodeType::Symbol)
+        {
+            if (node.string() == "true")
+                return true;
+            if (node.string() == "false" || node.string() == "nil")
+                return false;
+        }
+        return std::nullopt;
+    }
+
+    bool Optimizer::isPure(const Node& node)
+    {
+        // reading a variable fails when it isn't bound yet, only the builtin constants are safe
+        if (isLiteral(node))
+            return true;
+
+        if (node.nodeType() == NodeType::List)
+        {
+            const std::vector<Node>& list = node.constList();
+            if (list.empty())
+                return true;
+            // a function capturing variables reads them when it is created
+            if (list[0].nodeType() == NodeType::Keyword && list[0].keyword() == Keyword::Fun)
+                return list.size() == 3 && list[1].nodeType() == NodeType::List &&
+                    std::ranges::none_of(list[1].constList(), [](const Node& arg) {
+                        return arg.nodeType() == NodeType::Capture;
+                    });
+            // the list instruction is always used for `list`, it can not be redefined
+            if (list[0].nodeType() == NodeType::Symbol && list[0].string() == "list")
+                return std::all_of(list.begin() + 1, list.end(), isPure);
+        }
+        return false;
     }
 
-    void Optimizer::runOnGlobalScopeVars(Node& node, const std::function<void(Node&, Node&, std::size_t)>& func)
+    void Optimizer::countBindings(const Node& node)
     {
-        auto i = node.constList().size();
-        // iterate only on the first level, using reverse iterators to avoid copy-delete-move to nowhere
-        for (auto it = node.list().rbegin(); it != node.list().rend(); ++it)
+        if (node.nodeType() != NodeType::List || node.constList().empty())
+            return;
+
+        const std::vector<Node>& list = node.constList();
+        if (list.size() > 1)
         {
-            i--;
+            const Node& first = list[0];
+            const Node& second = list[1];
+
+            if (first.nodeType() == NodeType::Keyword)
+            {
+                const Keyword kw = first.keyword();
+                if (kw == Keyword::Fun && second.nodeType() == NodeType::List)
+                {
+                    // captures are not counted, they copy the value of the variable they capture
+                    for (const auto& arg : second.constList())
+                    {
+                        if (arg.nodeType() == NodeType::Symbol)
+                            m_sym_bindings[arg.string()]++;
+                    }
+                }
+                else if ((kw == Keyword::Let || kw == Keyword::Mut || kw == Keyword::Set || kw == Keyword::Del) && second.nodeType() == NodeType::Symbol)
+                {
+                    m_sym_bindings[second.string()]++;
+                    if (kw == Keyword::Set || kw == Keyword::Del)
+                        m_sym_mutations.insert(second.string());
+                }
+            }
+            else if (first.nodeType() == NodeType::Symbol && second.nodeType() == NodeType::Symbol &&
+                     std::ranges::find(Language::UpdateRef, first.string()) != Language::UpdateRef.end())
+            {
+                m_sym_bindings[second.string()]++;
+                m_sym_mutations.insert(second.string());
+            }
+        }
+
+        for (const auto& child : list)
+            countBindings(child);
+    }
 
-            if (it->nodeType() == NodeType::List && !it->constList().empty() &&
-                it->constList()[0].nodeType() == NodeType::Keyword)
+    void Optimizer::foldBlock(Node& block, Constants* locals)
+    {
+        for (Node& child : block.list())
+        {
+            if (child.nodeType() == NodeType::List && !child.constList().empty() && child.constList()[0].nodeType() == NodeType::Keyword)
             {
-                Keyword kw = it->constList()[0].keyword();
+                const Keyword kw = child.constList()[0].keyword();
 
-                // eliminate nested begin blocks
+                // a nested block is run unconditionally, as part of the current one
                 if (kw == Keyword::Begin)
                 {
-                    runOnGlobalScopeVars(*it, func);
-                    // skip let/ mut detection
+                    foldBlock(child, locals);
+                    continue;
+                }
+
+                if (kw == Keyword::Let && child.constList().size() == 3 && child.constList()[1].nodeType() == NodeType::Symbol)
+                {
+                    Node& value = child.list()[2];
+                    // the arguments of a function can be read by name by the functions it calls
+                    const bool arguments_read_elsewhere = locals != nullptr || areArgumentsReadElsewhere(value);
+                    foldExpression(value, locals);
+
+                    // a constant bound only once can not be shadowed, nor be found in another scope than this one
+                    const std::string& name = child.constList()[1].string();
+                    if (isLiteral(value) && m_sym_bindings[name] == 1)
+                    {
+                        m_logger.debug("Propagating constant '{}'", name);
+                        (locals != nullptr ? *locals : m_global_constants).emplace(name, value);
+                    }
+                    // a function defined at the top level is inlined only after its definition, when it exists at runtime
+                    else if (locals == nullptr && m_sym_bindings[name] == 1 && isInlinable(name, value) &&
+                             (!arguments_read_elsewhere || !mayRunUserCode(value.constList()[2])))
+                    {
+                        m_logger.debug("Function '{}' can be inlined", name);
+                        m_inline_functions.emplace(name, value);
+                    }
                     continue;
                 }
-                // check if it's a let/mut declaration
-                if (kw == Keyword::Let || kw == Keyword::Mut)
-                    func(*it, node, i);
             }
+
+            foldExpression(child, locals);
         }
     }
 
-    void Optimizer::countOccurences(Node& node)
+    void Optimizer::foldExpression(Node& node, const Constants* locals)
     {
-        if (node.nodeType() == NodeType::Symbol || node.nodeType() == NodeType::Capture)
+        if (node.nodeType() == NodeType::Symbol)
         {
-            // check if it's the name of something declared in global scope
-            if (const auto name = node.string(); m_sym_appearances.contains(name))
-                m_sym_appearances[name]++;
+            const std::string& name = node.string();
+            if (locals != nullptr)
+            {
+                if (const auto it = locals->find(name); it != locals->end())
+                {
+                    node = it->second;
+                    return;
+                }
+            }
+            if (const auto it = m_global_constants.find(name); it != m_global_constants.end())
+                node = it->second;
+            return;
         }
-        else if (node.nodeType() == NodeType::List)
+        if (node.nodeType() != NodeType::List || node.constList().empty())
+            return;
+
+        std::vector<Node>& list = node.list();
+        if (list[0].nodeType() == NodeType::Keyword)
+        {
+            switch (list[0].keyword())
+            {
+                case Keyword::Fun:
+                    if (list.size() == 3)
+                    {
+                        // the constants of the enclosing function are not propagated, the nested function can be called after it returned
+                        Constants function_locals;
+                        Node& body = list[2];
+                        if (body.nodeType() == NodeType::List && !body.constList().empty() &&
+                            body.constList()[0].nodeType() == NodeType::Keyword && body.constList()[0].keyword() == Keyword::Begin)
+                            foldBlock(body, &function_locals);
+                        else
+                            foldExpression(body, &function_locals);
+                    }
+                    break;
+
+                case Keyword::Let:
+                case Keyword::Mut:
+                case Keyword::Set:
+                    if (list.size() == 3)
+                        foldExpression(list[2], locals);
+                    break;
+
+                case Keyword::If:
+                case Keyword::While:
+                case Keyword::Begin:
+                    for (std::size_t i = 1, end = list.size(); i < end; ++i)
+                        foldExpression(list[i], locals);
+                    break;
+
+                default:
+                    break;
+            }
+            return;
+        }
+
+        for (std::size_t i = 1, end = list.size(); i < end; ++i)
+            foldExpression(list[i], locals);
+
+        // a symbol called is never replaced, so that calling a constant reports the same error
+        if (list[0].nodeType() == NodeType::List)
+            foldExpression(list[0], locals);
+        else if (list[0].nodeType() == NodeType::Symbol)
+        {
+            if (std::optional<Node> result = evaluateOperator(node); result.has_value())
+            {
+                result->setFilename(node.filename());
+                result->setPos(node.line(), node.col());
+                node = std::move(result.value());
+            }
+            else if (std::optional<Node> body = inlineCall(node); body.has_value())
+            {
+                const std::string name = list[0].string();
+                m_logger.debug("Inlining call to '{}' at {}:{}", name, node.filename(), node.line());
+
+                body->setFilename(node.filename());
+                body->setPos(node.line(), node.col());
+                node = std::move(body.value());
+
+                // the arguments are now known, the body may be folded further
+                m_inlining.push_back(name);
+                foldExpression(node, locals);
+                m_inlining.pop_back();
+            }
+        }
+    }
+
+    std::optional<Node> Optimizer::evaluateOperator(const Node& node)
+    {
+        const std::vector<Node>& list = node.constList();
+        const std::string& name = list[0].string();
+        const std::size_t argc = list.size() - 1;
+
+        const auto args_are = [&list](const NodeType type) {
+            return std::all_of(list.begin() + 1, list.end(), [type](const Node& arg) {
+                return arg.nodeType() == type;
+            });
+        };
+
+        if (argc == 1)
+        {
+            const Node& arg = list[1];
+            if (name == "len" && arg.nodeType() == NodeType::String)
+                return Node(static_cast<double>(arg.string().size()));
+            if (name == "toString" && arg.nodeType() == NodeType::Number && isExactConstant(loadedNumber(arg.number())))
+                // same formatting as the VM
+                return Node(NodeType::String, fmt::format("{}", loadedNumber(arg.number())));
+            if (name == "toString" && arg.nodeType() == NodeType::String)
+                return arg;
+            return std::nullopt;
+        }
+        if (argc < 2)
+            return std::nullopt;
+
+        // (op a b c) is computed as (op (op a b) c), as the compiler does
+        if ((name == "+" || name == "-" || name == "*" || name == "/" || name == "mod") && args_are(NodeType::Number))
+        {
+            double result = loadedNumber(list[1].number());
+            for (auto it = list.begin() + 2, end = list.end(); it != end; ++it)
+            {
+                const double b = loadedNumber(it->number());
+                if (name == "+")
+                    result += b;
+                else if (name == "-")
+                    result -= b;
+                else if (name == "*")
+                    result *= b;
+                else if (name == "/")
+                {
+                    // the division by zero error is reported by the VM
+                    if (b == 0)
+                        return std::nullopt;
+                    result /= b;
+                }
+                else
+                    result = std::fmod(result, b);
+            }
+
+            // a result which can not be written exactly in the bytecode is computed by the VM
+            if (!isExactConstant(result))
+                return std::nullopt;
+            return Node(result);
+        }
+        if (name == "+" && args_are(NodeType::String))
+        {
+            std::string result = list[1].string();
+            for (auto it = list.begin() + 2, end = list.end(); it != end; ++it)
+                result += it->string();
+            return Node(NodeType::String, result);
+        }
+
+        if (argc != 2)
+            return std::nullopt;
+
+        const Node& a = list[1];
+        const Node& b = list[2];
+        if (a.nodeType() != b.nodeType() || (a.nodeType() != NodeType::Number && a.nodeType() != NodeType::String))
+            return std::nullopt;
+
+        const bool is_number = a.nodeType() == NodeType::Number;
+        const bool lt = is_number ? loadedNumber(a.number()) < loadedNumber(b.number()) : a.string() < b.string();
+        const bool eq = is_number ? loadedNumber(a.number()) == loadedNumber(b.number()) : a.string() == b.string();
+
+        // same definitions as the VM instructions
+        std::optional<bool> result;
+        if (name == "<")
+            result = lt;
+        else if (name == ">")
+            result = !eq && !lt;
+        else if (name == "<=")
+            result = lt || eq;
+        else if (name == ">=")
+            result = !lt;
+        else if (name == "=")
+            result = eq;
+        else if (name == "!=")
+            result = !eq;
+
+        if (!result.has_value())
+            return std::nullopt;
+        return result.value() ? getTrueNode() : getFalseNode();
+    }
+
+    bool Optimizer::isInlinable(const std::string& name, const Node& function) const
+    {
+        if (function.nodeType() != NodeType::List)
+            return false;
+
+        const std::vector<Node>& list = function.constList();
+        if (list.size() != 3 || list[0].nodeType() != NodeType::Keyword || list[0].keyword() != Keyword::Fun ||
+            list[1].nodeType() != NodeType::List)
+            return false;
+
+        // closures are not inlined, and the arguments must be distinct to be replaced by their values
+        const std::vector<Node>& arguments = list[1].constList();
+        for (auto it = arguments.begin(), end = arguments.end(); it != end; ++it)
+        {
+            if (it->nodeType() != NodeType::Symbol || std::any_of(arguments.begin(), it, [&it](const Node& arg) {
+                    return arg.string() == it->string();
+                }))
+                return false;
+        }
+
+        std::size_t size = 0;
+        return isInlinableBody(list[2], name, arguments, size);
+    }
+
+    bool Optimizer::areArgumentsReadElsewhere(const Node& function)
+    {
+        if (function.nodeType() != NodeType::List || function.constList().size() != 3 ||
+            function.constList()[1].nodeType() != NodeType::List)
+            return true;
+
+        std::unordered_map<std::string, unsigned> appearances;
+        std::swap(appearances, m_sym_appearances);
+        countOccurences(function);
+        std::swap(appearances, m_sym_appearances);
+
+        return std::ranges::any_of(function.constList()[1].constList(), [&](const Node& arg) {
+            return arg.nodeType() == NodeType::Symbol && appearances[arg.string()] != m_sym_appearances[arg.string()];
+        });
+    }
+
+    bool Optimizer::isInlinableBody(const Node& node, const std::string& name, const std::vector<Node>& arguments, std::size_t& size) const
+    {
+        if (++size > MaxInlinedNodes)
+            return false;
+
+        switch (node.nodeType())
+        {
+            case NodeType::Number:
+            case NodeType::String:
+                return true;
+
+            // the free symbols are found by the caller in the same scopes as the function would
+            case NodeType::Symbol:
+                // in place list operations modify the arguments, which would become the variables given by the caller
+                return node.string() != name && std::ranges::find(Language::UpdateRef, node.string()) == Language::UpdateRef.end();
+
+            case NodeType::List:
+            {
+                const std::vector<Node>& list = node.constList();
+                if (list.empty())
+                    return true;
+
+                // the variables defined in the body would be defined in the scope of the caller
+                if (list[0].nodeType() == NodeType::Keyword)
+                {
+                    if (list[0].keyword() != Keyword::If || list.size() < 3 || list.size() > 4)
+                        return false;
+                }
+                else if (list[0].nodeType() != NodeType::Symbol)
+                    return false;
+
+                return std::all_of(list.begin() + 1, list.end(), [&](const Node& child) {
+                    return isInlinableBody(child, name, arguments, size);
+                }) && (list[0].nodeType() == NodeType::Keyword || isInlinableBody(list[0], name, arguments, size));
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    std::optional<Node> Optimizer::inlineCall(const Node& call) const
+    {
+        const std::vector<Node>& list = call.constList();
+        const std::string& name = list[0].string();
+
+        const auto it = m_inline_functions.find(name);
+        if (it == m_inline_functions.end() || std::ranges::find(m_inlining, name) != m_inlining.end())
+            return std::nullopt;
+
+        const std::vector<Node>& arguments = it->second.constList()[1].constList();
+        const Node& body = it->second.constList()[2];
+        // the arity error is reported by the VM
+        if (list.size() - 1 != arguments.size())
+            return std::nullopt;
+
+        const std::vector<Node> values(list.begin() + 1, list.end());
+        const bool may_run_user_code = mayRunUserCode(body);
+        for (const Node& value : values)
+        {
+            if (isLiteral(value))
+                continue;
+            // a symbol given to a function is read when the function is called, and must have the same value when the body reads it
+            if (value.nodeType() != NodeType::Symbol || isInstruction(value.string()) ||
+                (may_run_user_code && m_sym_mutations.contains(value.string())))
+                return std::nullopt;
+        }
+
+        Node inlined = body;
+        if (!replaceArguments(inlined, arguments, values, /* is_called= */ false))
+            return std::nullopt;
+        return inlined;
+    }
+
+    void Optimizer::hoistLoopInvariants(Node& node, const bool is_local)
+    {
+        if (node.nodeType() != NodeType::List || node.constList().empty())
+            return;
+
+        std::vector<Node>& list = node.list();
+        const bool is_function = list[0].nodeType() == NodeType::Keyword && list[0].keyword() == Keyword::Fun;
+        for (Node& child : list)
+            hoistLoopInvariants(child, is_local || is_function);
+
+        // the variables are defined in the block running the loop, right before it
+        if (list[0].nodeType() != NodeType::Keyword || list[0].keyword() != Keyword::Begin)
+            return;
+
+        for (std::size_t i = 1; i < list.size(); ++i)
+        {
+            const Node& child = list[i];
+            if (child.nodeType() != NodeType::List || child.constList().size() != 3 ||
+                child.constList()[0].nodeType() != NodeType::Keyword || child.constList()[0].keyword() != Keyword::While)
+                continue;
+
+            std::vector<Node> before;
+            hoistFromLoop(list[i], is_local, before);
+            list.insert(list.begin() + static_cast<long>(i), before.begin(), before.end());
+            i += before.size();
+        }
+    }
+
+    void Optimizer::hoistFromLoop(Node& loop, const bool is_local, std::vector<Node>& before)
+    {
+        Loop info;
+        collectBoundSymbols(loop, info.bound_symbols);
+        info.runs_user_code = mayRunUserCode(loop);
+        info.is_local = is_local;
+
+        // the condition is computed at least once, before the body. Once the loop is guarded by it, it is computed
+        // twice before the first iteration, which is only possible if it has no side effects
+        std::vector<Node> in_body;
+        collectInvariants(loop.list()[1], info, before);
+        std::unordered_set<std::string> bound_in_condition;
+        collectBoundSymbols(loop.constList()[1], bound_in_condition);
+        if (!mayRunUserCode(loop.constList()[1]) && bound_in_condition.empty())
+            collectInvariants(loop.list()[2], info, in_body);
+
+        if (in_body.empty())
+            return;
+
+        // (while cond body) ---> (if cond { invariants... (while cond body) })
+        Node block(NodeType::List);
+        block.push_back(Node(Keyword::Begin));
+        for (Node& definition : in_body)
+            block.push_back(std::move(definition));
+        block.push_back(loop);
+        block.setFilename(loop.filename());
+        block.setPos(loop.line(), loop.col());
+
+        Node guard(NodeType::List);
+        guard.push_back(Node(Keyword::If));
+        guard.push_back(loop.constList()[1]);
+        guard.push_back(std::move(block));
+        guard.setFilename(loop.filename());
+        guard.setPos(loop.line(), loop.col());
+        loop = std::move(guard);
+    }
+
+    bool Optimizer::collectInvariants(Node& node, const Loop& loop, std::vector<Node>& hoisted)
+    {
+        const auto hoist = [this, &node, &loop, &hoisted]() {
+            // in a function, the arguments are loaded by index and the other variables by name, which is slower
+            if (instructionsCount(node) < (loop.is_local ? 3u : 2u))
+                return cannotThrow(node);
+
+            const std::string name = fmt::format("#invariant-{}", m_hoisted_count++);
+            m_logger.debug("Moving loop invariant expression out of its loop at {}:{}", node.filename(), node.line());
+
+            Node variable(NodeType::Symbol, name);
+            variable.setFilename(node.filename());
+            variable.setPos(node.line(), node.col());
+
+            Node definition(NodeType::List);
+            definition.push_back(Node(Keyword::Let));
+            definition.push_back(variable);
+            definition.push_back(std::move(node));
+            definition.setFilename(variable.filename());
+            definition.setPos(variable.line(), variable.col());
+
+            hoisted.push_back(std::move(definition));
+            node = std::move(variable);
+            return true;
+        };
+
+        if (node.nodeType() == NodeType::Field)
+            return isLoopInvariant(node, loop) && hoist();
+        if (node.nodeType() != NodeType::List || node.constList().empty())
+            return true;
+
+        std::vector<Node>& list = node.list();
+        if (list[0].nodeType() == NodeType::Keyword)
+        {
+            switch (list[0].keyword())
+            {
+                case Keyword::Begin:
+                    return std::all_of(list.begin() + 1, list.end(), [&](Node& child) {
+                        return collectInvariants(child, loop, hoisted);
+                    });
+
+                // the value is computed before the variable is bound, which is a side effect
+                case Keyword::Let:
+                case Keyword::Mut:
+                case Keyword::Set:
+                    if (list.size() == 3)
+                        collectInvariants(list[2], loop, hoisted);
+                    return false;
+
+                // creating a function doesn't run its body
+                case Keyword::Fun:
+                    return true;
+
+                // only the condition is computed each time
+                case Keyword::If:
+                case Keyword::While:
+                    if (list.size() > 1)
+                        collectInvariants(list[1], loop, hoisted);
+                    return false;
+
+                default:
+                    return false;
+            }
+        }
+
+        if (list[0].nodeType() != NodeType::Symbol)
+            return false;
+
+        const std::string& name = list[0].string();
+        if (isPureOperator(name))
+        {
+            if (isLoopInvariant(node, loop))
+                return hoist();
+            // the arguments of an operator are computed from left to right, then the operator can throw
+            return std::all_of(list.begin() + 1, list.end(), [&](Node& child) {
+                return collectInvariants(child, loop, hoisted);
+            }) && cannotThrow(node);
+        }
+        // only the first operand is always computed
+        if ((name == Language::And || name == Language::Or) && list.size() > 1)
+            collectInvariants(list[1], loop, hoisted);
+        return false;
+    }
+
+    bool Optimizer::isLoopInvariant(const Node& node, const Loop& loop) const
+    {
+        // a variable can be modified by the functions called in the loop, unless it is never modified
+        const auto is_unchanged = [this, &loop](const std::string& name) {
+            return !loop.bound_symbols.contains(name) && (!loop.runs_user_code || !m_sym_mutations.contains(name));
+        };
+
+        if (isLiteral(node))
+            return true;
+        if (node.nodeType() == NodeType::Symbol)
+            return is_unchanged(node.string());
+        // the fields of a closure can be modified by any function called in the loop, through a reference
+        if (node.nodeType() == NodeType::Field)
+            return !loop.runs_user_code && std::ranges::all_of(node.constList(), [&is_unchanged](const Node& child) {
+                return child.nodeType() == NodeType::Symbol && is_unchanged(child.string());
+            });
+
+        if (node.nodeType() != NodeType::List || node.constList().size() < 2)
+            return false;
+
+        const std::vector<Node>& list = node.constList();
+        return list[0].nodeType() == NodeType::Symbol && isPureOperator(list[0].string()) &&
+            std::all_of(list.begin() + 1, list.end(), [this, &loop](const Node& child) {
+                return isLoopInvariant(child, loop);
+            });
+    }
+
+    void Optimizer::collectBoundSymbols(const Node& node, std::unordered_set<std::string>& symbols)
+    {
+        if (node.nodeType() != NodeType::List || node.constList().empty())
+            return;
+
+        const std::vector<Node>& list = node.constList();
+        if (list.size() > 1)
         {
-            // iterate over children
-            for (std::size_t i = 0, end = node.constList().size(); i != end; ++i)
-                countOccurences(node.list()[i]);
+            const Node& first = list[0];
+            const Node& second = list[1];
+
+            if (first.nodeType() == NodeType::Keyword)
+            {
+                const Keyword kw = first.keyword();
+                if (kw == Keyword::Fun && second.nodeType() == NodeType::List)
+                {
+                    for (const auto& arg : second.constList())
+                    {
+                        if (arg.nodeType() == NodeType::Symbol)
+                            symbols.insert(arg.string());
+                    }
+                }
+                else if ((kw == Keyword::Let || kw == Keyword::Mut || kw == Keyword::Set || kw == Keyword::Del) && second.nodeType() == NodeType::Symbol)
+                    symbols.insert(second.string());
+            }
+            else if (first.nodeType() == NodeType::Symbol && second.nodeType() == NodeType::Symbol &&
+                     std::ranges::find(Language::UpdateRef, first.string()) != Language::UpdateRef.end())
+                symbols.insert(second.string());
         }
+
+        for (const auto& child : list)
+            collectBoundSymbols(child, symbols);
     }
 }
@@ -352,7 +352,20 @@ namespace Ark
             { APPEND, ArgKind::Raw },
             { CONCAT, ArgKind::Raw },
             { APPEND_IN_PLACE, ArgKind::Raw },
-            { CONCAT_IN_PLACE, ArgKind::Raw }
+            { CONCAT_IN_PLACE, ArgKind::Raw },
+            { LOAD_LOCAL, ArgKind::Raw },
+            { STORE_LOCAL, ArgKind::Raw },
+            { LOAD_UPVALUE, ArgKind::Raw },
+            { GLOBAL_LOAD, ArgKind::Symbol },
+            { GLOBAL_STORE, ArgKind::Symbol },
+            { TAIL_CALL, ArgKind::Raw },
+            { GET_FIELD_CALL, ArgKind::Raw },
+            { JUMP_IF_LT, ArgKind::Raw },
+            { JUMP_IF_LE, ArgKind::Raw },
+            { JUMP_IF_GT, ArgKind::Raw },
+            { JUMP_IF_GE, ArgKind::Raw },
+            { JUMP_IF_EQ, ArgKind::Raw },
+            { JUMP_IF_NEQ, ArgKind::Raw }
         };
 
         const auto color_print_inst = [&syms, &vals, &stringify_value](const std::string& name, std::optional<Arg> arg = std::nullopt) {
@@ -25,6 +25,7 @@ namespace Ark::internal
     void Compiler::process(const Node& ast)
     {
         m_code_pages.emplace_back();  // create empty page
+        findFrameBoundSymbols(ast, /* in_function */ false);
 
         // gather symbols, values, and start to create code segments
         compileExpression(
@@ -85,6 +86,83 @@ namespace Ark::internal
         return true;  // any other node, function call, symbol, number...
     }
 
+    bool Compiler::isCaptureShadowed(const std::string& name, const Node& body, const bool in_nested_function)
+    {
+        if (body.nodeType() != NodeType::List || body.constList().empty())
+            return false;
+
+        bool is_nested_function = in_nested_function;
+        if (const Node& first = body.constList()[0]; first.nodeType() == NodeType::Keyword && body.constList().size() > 1)
+        {
+            const Node& sym = body.constList()[1];
+            const bool is_name = sym.nodeType() == NodeType::Symbol && sym.string() == name;
+
+            // a nested function has its own frame for its variables, but it can still delete ours
+            if (is_name && (first.keyword() == Keyword::Del || (!in_nested_function && (first.keyword() == Keyword::Let || first.keyword() == Keyword::Mut))))
+                return true;
+            if (first.keyword() == Keyword::Fun)
+                is_nested_function = true;
+        }
+
+        return std::ranges::any_of(body.constList(), [&name, is_nested_function](const Node& child) {
+            return isCaptureShadowed(name, child, is_nested_function);
+        });
+    }
+
+    void Compiler::findFrameBoundSymbols(const Node& node, const bool in_function)
+    {
+        if (node.nodeType() != NodeType::List || node.constList().empty())
+            return;
+
+        bool is_function = in_function;
+        if (const Node& first = node.constList()[0]; first.nodeType() == NodeType::Keyword && node.constList().size() > 1)
+        {
+            const Node& second = node.constList()[1];
+            if (first.keyword() == Keyword::Fun && second.nodeType() == NodeType::List)
+            {
+                for (const auto& arg : second.constList())
+                {
+                    if (arg.nodeType() == NodeType::Symbol || arg.nodeType() == NodeType::Capture)
+                        m_frame_bound_symbols.insert(arg.string());
+                }
+                is_function = true;
+            }
+            else if (in_function && (first.keyword() == Keyword::Let || first.keyword() == Keyword::Mut) && second.nodeType() == NodeType::Symbol)
+                m_frame_bound_symbols.insert(second.string());
+        }
+
+        for (const auto& child : node.constList())
+            findFrameBoundSymbols(child, is_function);
+    }
+
+    bool Compiler::isGlobalOnly(const std::string& name) const noexcept
+    {
+        // at the top level, LOAD_SYMBOL only has the global scope to search and can be fused by the IR optimizer
+        return !m_locals.empty() && !m_frame_bound_symbols.contains(name);
+    }
+
+    std::optional<uint16_t> Compiler::findLocalSlot(const std::string& name) const noexcept
+    {
+        if (m_locals.empty())
+            return std::nullopt;
+
+        const auto& args = m_locals.back().arguments;
+        if (const auto it = std::ranges::find(args, name); it != args.end())
+            return static_cast<uint16_t>(std::distance(args.begin(), it));
+        return std::nullopt;
+    }
+
+    std::optional<uint16_t> Compiler::findUpvalueSlot(const std::string& name) const noexcept
+    {
+        if (m_locals.empty())
+            return std::nullopt;
+
+        const auto& captures = m_locals.back().captures;
+        if (const auto it = std::ranges::find(captures, name); it != captures.end())
+            return static_cast<uint16_t>(std::distance(captures.begin(), it));
+        return std::nullopt;
+    }
+
     bool Compiler::isUnaryInst(const Instruction inst) noexcept
     {
         switch (inst)
@@ -216,6 +294,12 @@ namespace Ark::internal
             page(p).emplace_back(Instruction::BUILTIN, it_builtin.value());
         else if (getOperator(name).has_value())
             throwCompilerError(fmt::format("Found a free standing operator: `{}`", name), x);
+        else if (const auto slot = findLocalSlot(name))
+            page(p).emplace_back(LOAD_LOCAL, slot.value());
+        else if (const auto upvalue = findUpvalueSlot(name))
+            page(p).emplace_back(LOAD_UPVALUE, upvalue.value());
+        else if (isGlobalOnly(name))
+            page(p).emplace_back(GLOBAL_LOAD, addSymbol(x));
         else
             page(p).emplace_back(LOAD_SYMBOL, addSymbol(x));  // using the variable
 
@@ -327,17 +411,32 @@ namespace Ark::internal
         page(p).emplace_back(is_closure ? MAKE_CLOSURE : LOAD_CONST, addValue(function_body_page.index, x));
 
         // pushing arguments from the stack into variables in the new scope
+        // they are stored in order by the VM, thus we can access them by slot in the function body
+        FunctionLocals locals;
         for (const auto& node : x.constList()[1].constList())
         {
             if (node.nodeType() == NodeType::Symbol)
+            {
                 page(function_body_page).emplace_back(STORE, addSymbol(node));
+                if (std::ranges::find(locals.arguments, node.string()) == locals.arguments.end())
+                    locals.arguments.push_back(node.string());
+            }
+            else if (node.nodeType() == NodeType::Capture)
+                // arguments shadow captured variables, and the closure scope is left untouched
+                // if the variable is redefined or deleted, thus we have to load it by name
+                locals.captures.push_back(
+                    std::ranges::find(locals.arguments, node.string()) == locals.arguments.end() && !isCaptureShadowed(node.string(), x.constList()[2])
+                        ? node.string()
+                        : "");
         }
+        m_locals.push_back(std::move(locals));
 
         // push body of the function
         compileExpression(x.constList()[2], function_body_page, false, true, var_name);
 
         // return last value on the stack
         page(function_body_page).emplace_back(RET);
+        m_locals.pop_back();
 
         // if the computed function is unused, pop it
         if (is_result_unused)
@@ -364,6 +463,10 @@ namespace Ark::internal
 
         if (n == Keyword::Let || n == Keyword::Mut)
             page(p).emplace_back(STORE, i);
+        else if (const auto slot = findLocalSlot(name))
+            page(p).emplace_back(STORE_LOCAL, slot.value());
+        else if (isGlobalOnly(name))
+            page(p).emplace_back(GLOBAL_STORE, i);
         else
             page(p).emplace_back(SET_VAL, i);
     }
@@ -504,7 +607,14 @@ namespace Ark::internal
                     if (it->nodeType() != NodeType::Capture)
                         args_count++;
                 }
-                // call the procedure
+                // call the procedure, reusing the current frame if the call is the last thing the function does.
+                // builtins do not need it and are left to the CALL_BUILTIN super instruction
+                const bool is_builtin = node.nodeType() == NodeType::Symbol && getBuiltin(node.string()).has_value();
+                if (is_terminal && !is_builtin)
+                {
+                    page(p).emplace_back(TAIL_CALL, args_count);
+                    return;  // skip the potential Instruction::POP at the end
+                }
                 page(p).emplace_back(CALL, args_count);
             }
         }
@@ -0,0 +1,316 @@
+#include <Ark/Compiler/IntermediateRepresentation/ControlFlowGraph.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace Ark::internal::IR
+{
+    namespace
+    {
+        bool isJump(const Entity& entity)
+        {
+            return entity.kind() == Kind::Goto || entity.kind() == Kind::GotoIfTrue || entity.kind() == Kind::GotoIfFalse || entity.kind() == Kind::GotoWithInst;
+        }
+
+        /// The entities after this one can only be reached by jumping to them
+        bool endsFlow(const Entity& entity)
+        {
+            return entity.kind() == Kind::Goto || (entity.kind() == Kind::Opcode && (entity.inst() == RET || entity.inst() == HALT));
+        }
+
+        Entity retarget(const Entity& jump, const Entity& label)
+        {
+            switch (jump.kind())
+            {
+                case Kind::GotoIfTrue:
+                    return Entity::GotoIf(label, true);
+                case Kind::GotoIfFalse:
+                    return Entity::GotoIf(label, false);
+                case Kind::GotoWithInst:
+                    return Entity::GotoWithInst(label, jump.inst());
+                default:
+                    return Entity::Goto(label);
+            }
+        }
+    }
+
+    ControlFlowGraph::ControlFlowGraph(const Block& block)
+    {
+        m_blocks.emplace_back();
+        for (const Entity& entity : block)
+        {
+            if (entity.kind() == Kind::Label)
+            {
+                if (!m_blocks.back().entities.empty())
+                    m_blocks.emplace_back();
+                m_blocks.back().labels.push_back(entity);
+            }
+            else
+            {
+                m_blocks.back().entities.push_back(entity);
+                if (isJump(entity) || endsFlow(entity))
+                    m_blocks.emplace_back();
+            }
+        }
+
+        if (m_blocks.size() > 1 && m_blocks.back().labels.empty() && m_blocks.back().entities.empty())
+            m_blocks.pop_back();
+
+        computeEdges();
+    }
+
+    Block ControlFlowGraph::lower() const
+    {
+        Block block;
+        for (const BasicBlock& basic_block : m_blocks)
+        {
+            block.insert(block.end(), basic_block.labels.begin(), basic_block.labels.end());
+            block.insert(block.end(), basic_block.entities.begin(), basic_block.entities.end());
+        }
+
+        return block;
+    }
+
+    std::size_t ControlFlowGraph::threadJumps()
+    {
+        std::size_t count = 0;
+        bool changed = true;
+
+        while (changed)
+        {
+            changed = false;
+
+            for (std::size_t i = 0, end = m_blocks.size(); i < end; ++i)
+            {
+                Block& entities = m_blocks[i].entities;
+                if (entities.empty() || !isJump(entities.back()))
+                    continue;
+
+                Entity& jump = entities.back();
+                const std::size_t target = blockOf(jump.label());
+                if (target == end)
+                    continue;
+
+                // the first block executed after this one when not jumping, the blocks without entities are skipped
+                const auto fallthrough = [this, end](const std::size_t index) {
+                    std::size_t next = index + 1;
+                    while (next < end && m_blocks[next].entities.empty())
+                        ++next;
+                    return next;
+                };
+                const auto is_goto_only = [](const BasicBlock& basic_block) {
+                    return basic_block.entities.size() == 1 && basic_block.entities.front().kind() == Kind::Goto;
+                };
+
+                // jumping to a jump: go directly to its target, stopping on the cycles made of jumps only
+                std::size_t final_target = target;
+                std::unordered_set<std::size_t> visited = { target };
+                while (is_goto_only(m_blocks[final_target]))
+                {
+                    const std::size_t next = blockOf(m_blocks[final_target].entities.front().label());
+                    if (next == end || visited.contains(next))
+                        break;
+                    visited.insert(next);
+                    final_target = next;
+                }
+
+                if (final_target != target)
+                    jump = retarget(jump, labelOf(final_target));
+                // jumping to a return: return directly
+                else if (const Block& target_entities = m_blocks[target].entities;
+                         jump.kind() == Kind::Goto && target_entities.size() == 1 && target_entities.front().kind() == Kind::Opcode && target_entities.front().inst() == RET)
+                    jump = target_entities.front();
+                // jumping to the next block: let the execution fall through
+                else if (jump.kind() == Kind::Goto && target > i && fallthrough(i) >= target)
+                    entities.pop_back();
+                // GOTO_IF_TRUE A ; GOTO B ; A: ---> GOTO_IF_FALSE B ; A:
+                else if ((jump.kind() == Kind::GotoIfTrue || jump.kind() == Kind::GotoIfFalse) && i + 1 < end &&
+                         m_blocks[i + 1].labels.empty() && is_goto_only(m_blocks[i + 1]) && fallthrough(i + 1) == target &&
+                         blockOf(m_blocks[i + 1].entities.front().label()) != end)
+                {
+                    jump = Entity::GotoIf(labelOf(blockOf(m_blocks[i + 1].entities.front().label())), jump.kind() == Kind::GotoIfFalse);
+                    m_blocks[i + 1].entities.clear();
+                }
+                else
+                    continue;
+
+                changed = true;
+                ++count;
+            }
+        }
+
+        computeEdges();
+        return count;
+    }
+
+    std::size_t ControlFlowGraph::removeUnreachableBlocks()
+    {
+        std::vector<bool> reached(m_blocks.size(), false);
+        std::vector<std::size_t> to_visit = { 0 };
+        reached[0] = true;
+
+        while (!to_visit.empty())
+        {
+            const std::size_t current = to_visit.back();
+            to_visit.pop_back();
+
+            for (const std::size_t successor : m_blocks[current].successors)
+            {
+                if (!reached[successor])
+                {
+                    reached[successor] = true;
+                    to_visit.push_back(successor);
+                }
+            }
+        }
+
+        std::vector<BasicBlock> blocks;
+        blocks.reserve(m_blocks.size());
+        for (std::size_t i = 0, end = m_blocks.size(); i < end; ++i)
+        {
+            if (reached[i])
+                blocks.push_back(std::move(m_blocks[i]));
+        }
+
+        const std::size_t removed = m_blocks.size() - blocks.size();
+        m_blocks = std::move(blocks);
+        computeEdges();
+
+        return removed;
+    }
+
+    std::size_t ControlFlowGraph::detectLoops()
+    {
+        enum class Color
+        {
+            White,  ///< Not visited yet
+            Grey,   ///< Being visited, on the current path
+            Black   ///< Visited with all its successors
+        };
+
+        std::vector colors(m_blocks.size(), Color::White);
+        // a block and the index of the next successor to visit
+        std::vector<std::pair<std::size_t, std::size_t>> path = { { 0, 0 } };
+        colors[0] = Color::Grey;
+
+        std::size_t count = 0;
+        for (BasicBlock& block : m_blocks)
+            block.is_loop_header = false;
+
+        while (!path.empty())
+        {
+            auto& [current, next_successor] = path.back();
+            if (next_successor == m_blocks[current].successors.size())
+            {
+                colors[current] = Color::Black;
+                path.pop_back();
+                continue;
+            }
+
+            const std::size_t successor = m_blocks[current].successors[next_successor++];
+            if (colors[successor] == Color::Grey && !m_blocks[successor].is_loop_header)
+            {
+                m_blocks[successor].is_loop_header = true;
+                ++count;
+            }
+            else if (colors[successor] == Color::White)
+            {
+                colors[successor] = Color::Grey;
+                path.emplace_back(successor, 0);
+            }
+        }
+
+        return count;
+    }
+
+    void ControlFlowGraph::computeLiveness()
+    {
+        std::vector<std::set<uint16_t>> uses(m_blocks.size());
+        std::vector<std::set<uint16_t>> defs(m_blocks.size());
+
+        for (std::size_t i = 0, end = m_blocks.size(); i < end; ++i)
+        {
+            m_blocks[i].live_in.clear();
+            m_blocks[i].live_out.clear();
+
+            for (const Entity& entity : m_blocks[i].entities)
+            {
+                if (entity.kind() != Kind::Opcode)
+                    continue;
+                if (entity.inst() == LOAD_LOCAL && !defs[i].contains(entity.primaryArg()))
+                    uses[i].insert(entity.primaryArg());
+                else if (entity.inst() == STORE_LOCAL)
+                    defs[i].insert(entity.primaryArg());
+            }
+        }
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+
+            for (std::size_t i = m_blocks.size(); i-- > 0;)
+            {
+                BasicBlock& block = m_blocks[i];
+                for (const std::size_t successor : block.successors)
+                    block.live_out.insert(m_blocks[successor].live_in.begin(), m_blocks[successor].live_in.end());
+
+                std::set<uint16_t> live_in = uses[i];
+                for (const uint16_t slot : block.live_out)
+                {
+                    if (!defs[i].contains(slot))
+                        live_in.insert(slot);
+                }
+
+                if (live_in != block.live_in)
+                {
+                    block.live_in = std::move(live_in);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    void ControlFlowGraph::computeEdges()
+    {
+        m_label_to_block.clear();
+        for (std::size_t i = 0, end = m_blocks.size(); i < end; ++i)
+        {
+            m_blocks[i].predecessors.clear();
+            m_blocks[i].successors.clear();
+            for (const Entity& label : m_blocks[i].labels)
+                m_label_to_block[label.label()] = i;
+        }
+
+        const auto add_edge = [this](const std::size_t from, const std::size_t to) {
+            if (std::ranges::find(m_blocks[from].successors, to) != m_blocks[from].successors.end())
+                return;
+            m_blocks[from].successors.push_back(to);
+            m_blocks[to].predecessors.push_back(from);
+        };
+
+        for (std::size_t i = 0, end = m_blocks.size(); i < end; ++i)
+        {
+            const Block& entities = m_blocks[i].entities;
+            if (!entities.empty() && isJump(entities.back()))
+            {
+                if (const std::size_t target = blockOf(entities.back().label()); target != end)
+                    add_edge(i, target);
+            }
+            if ((entities.empty() || !endsFlow(entities.back())) && i + 1 < end)
+                add_edge(i, i + 1);
+        }
+    }
+
+    std::size_t ControlFlowGraph::blockOf(const label_t label) const
+    {
+        if (const auto it = m_label_to_block.find(label); it != m_label_to_block.end())
+            return it->second;
+        return m_blocks.size();
+    }
+
+    const Entity& ControlFlowGraph::labelOf(const std::size_t index) const
+    {
+        return m_blocks[index].labels.front();
+    }
+}
@@ -29,6 +29,7 @@ namespace Ark::internal::IR
     {
         auto jump = Entity(Kind::Goto);
         jump.m_label = label.m_label;
+        jump.m_inst = JUMP;
 
         return jump;
     }
@@ -37,6 +38,16 @@ namespace Ark::internal::IR
     {
         auto jump = Entity(cond ? Kind::GotoIfTrue : Kind::GotoIfFalse);
         jump.m_label = label.m_label;
+        jump.m_inst = cond ? POP_JUMP_IF_TRUE : POP_JUMP_IF_FALSE;
+
+        return jump;
+    }
+
+    Entity Entity::GotoWithInst(const Entity& label, const Instruction inst)
+    {
+        auto jump = Entity(Kind::GotoWithInst);
+        jump.m_label = label.m_label;
+        jump.m_inst = inst;
 
         return jump;
     }
@@ -92,15 +92,13 @@ namespace Ark::internal
                 switch (inst.kind())
                 {
                     case IR::Kind::Goto:
-                        pushWord(Word(JUMP, label_to_position[inst.label()]));
-                        break;
-
+                        [[fallthrough]];
                     case IR::Kind::GotoIfTrue:
-                        pushWord(Word(POP_JUMP_IF_TRUE, label_to_position[inst.label()]));
-                        break;
-
+                        [[fallthrough]];
                     case IR::Kind::GotoIfFalse:
-                        pushWord(Word(POP_JUMP_IF_FALSE, label_to_position[inst.label()]));
+                        [[fallthrough]];
+                    case IR::Kind::GotoWithInst:
+                        pushWord(Word(inst.inst(), label_to_position[inst.label()]));
                         break;
 
                     case IR::Kind::Opcode:
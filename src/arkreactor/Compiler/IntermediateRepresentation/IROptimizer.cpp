@@ -1,16 +1,12 @@
 #include <Ark/Compiler/IntermediateRepresentation/IROptimizer.hpp>
 
 #include <utility>
+#include <fmt/ranges.h>
+#include <Ark/Compiler/IntermediateRepresentation/ControlFlowGraph.hpp>
 #include <Ark/Builtins/Builtins.hpp>
 
 namespace Ark::internal
 {
-    struct EntityWithOffset
-    {
-        IR::Entity entity;
-        std::size_t offset;
-    };
-
     IROptimizer::IROptimizer(const unsigned debug) :
         m_logger("IROptimizer", debug)
     {}
@@ -20,58 +16,33 @@ namespace Ark::internal
         m_symbols = symbols;
         m_values = values;
 
-        auto map = []<typename T>(const std::optional<T>& opt, auto&& lambda) -> decltype(std::optional(lambda(opt.value()))) {
-            if (opt.has_value())
-                return lambda(opt.value());
-            return std::nullopt;
-        };
-
-        auto or_else = []<typename T>(const std::optional<T>& opt, auto&& lambda) -> std::optional<T> {
-            if (!opt.has_value())
-                return lambda();
-            return opt;
-        };
-
         for (const auto& block : pages)
         {
-            m_ir.emplace_back();
-            IR::Block& current_block = m_ir.back();
+            // simplify the control flow first, the rules can then match the entities which were separated by a jump
+            IR::ControlFlowGraph graph(block);
+            const std::size_t threaded_jumps = graph.threadJumps();
+            const std::size_t removed_blocks = graph.removeUnreachableBlocks();
+            const std::size_t loops = graph.detectLoops();
+            m_logger.debug(
+                "Page {}: {} blocks, {} loops, {} jumps threaded, {} unreachable blocks removed",
+                m_ir.size(), graph.blocks().size(), loops, threaded_jumps, removed_blocks);
+
+            if (m_logger.shouldTrace())
+            {
+                graph.computeLiveness();
+                for (std::size_t i = 0, end = graph.blocks().size(); i < end; ++i)
+                    m_logger.trace("  block {}: live in {}, live out {}", i, graph.blocks()[i].live_in, graph.blocks()[i].live_out);
+            }
 
-            std::size_t i = 0;
-            const std::size_t end = block.size();
+            IR::Block& current_block = m_ir.emplace_back(graph.lower());
 
-            while (i < end)
+            // a rule can match the entities created by another one, apply them until nothing changes
+            bool changed = true;
+            while (changed)
             {
-                std::optional<EntityWithOffset> maybe_compacted = std::nullopt;
-
-                if (i + 1 < end)
-                    maybe_compacted = map(
-                        compactEntities(block[i], block[i + 1]),
-                        [](const auto& entity) {
-                            return std::make_optional<EntityWithOffset>(entity, 2);
-                        });
-                if (i + 2 < end)
-                    maybe_compacted = or_else(
-                        maybe_compacted,
-                        [&, this]() {
-                            return map(
-                                compactEntities(block[i], block[i + 1], block[i + 2]),
-                                [](const auto& entity) {
-                                    return std::make_optional<EntityWithOffset>(entity, 3);
-                                });
-                        });
-
-                if (maybe_compacted.has_value())
-                {
-                    auto [entity, offset] = maybe_compacted.value();
-                    current_block.emplace_back(entity);
-                    i += offset;
-                }
-                else
-                {
-                    current_block.emplace_back(block[i]);
-                    ++i;
-                }
+                changed = false;
+                for (const Rule& rule : rules())
+                    changed = applyRule(rule, current_block) || changed;
             }
         }
     }
@@ -81,68 +52,150 @@ namespace Ark::internal
         return m_ir;
     }
 
-    std::optional<IR::Entity> IROptimizer::compactEntities(const IR::Entity& first, const IR::Entity& second)
+    const std::vector<IROptimizer::Rule>& IROptimizer::rules()
     {
-        if (first.primaryArg() > IR::MaxValueForDualArg || second.primaryArg() > IR::MaxValueForDualArg)
-            return std::nullopt;
-
-        // LOAD_CONST x
-        // LOAD_CONST y
-        // ---> LOAD_CONST_LOAD_CONST x y
-        if (first.inst() == LOAD_CONST && second.inst() == LOAD_CONST)
-            return IR::Entity(LOAD_CONST_LOAD_CONST, first.primaryArg(), second.primaryArg());
-        // LOAD_CONST x
-        // STORE / SET_VAL a
-        // ---> LOAD_CONST_STORE x a ; LOAD_CONST_SET_VAL x a
-        if (first.inst() == LOAD_CONST && second.inst() == STORE)
-            return IR::Entity(LOAD_CONST_STORE, first.primaryArg(), second.primaryArg());
-        if (first.inst() == LOAD_CONST && second.inst() == SET_VAL)
-            return IR::Entity(LOAD_CONST_SET_VAL, first.primaryArg(), second.primaryArg());
-        // LOAD_SYMBOL a
-        // STORE / SET_VAL b
-        // ---> STORE_FROM a b ; SET_VAL_FROM a b
-        if (first.inst() == LOAD_SYMBOL && second.inst() == STORE)
-            return IR::Entity(STORE_FROM, first.primaryArg(), second.primaryArg());
-        if (first.inst() == LOAD_SYMBOL && second.inst() == SET_VAL)
-            return IR::Entity(SET_VAL_FROM, first.primaryArg(), second.primaryArg());
-        // BUILTIN i
-        // CALL n
-        // ---> CALL_BUILTIN i n
-        if (first.inst() == BUILTIN && second.inst() == CALL && Builtins::builtins[first.primaryArg()].second.isFunction())
-            return IR::Entity(CALL_BUILTIN, first.primaryArg(), second.primaryArg());
-
-        return std::nullopt;
+        // COMPARISON
+        // GOTO_IF_TRUE / GOTO_IF_FALSE label
+        // ---> JUMP_IF_<comparison> label
+        // each comparison is the opposite of another one, which is used when jumping on false
+        const auto compare_and_jump = [](const Instruction comparison, const Instruction jump, const Instruction fused) {
+            return Rule {
+                .pattern = { comparison, jump },
+                .replacement = [fused](const Entities e) { return IR::Entity::GotoWithInst(e[1], fused); }
+            };
+        };
+
+        // the longest sequences come first, so that they aren't broken by a shorter rule
+        static const std::vector<Rule> table = {
+            // LOAD_CONST n (1)
+            // LOAD_SYMBOL a
+            // ADD
+            // ---> INCREMENT a
+            { .pattern = { LOAD_CONST, LOAD_SYMBOL, ADD },
+              .condition = [](const IROptimizer& self, const Entities e) { return self.isNumber(e[0].primaryArg(), 1); },
+              .replacement = [](const Entities e) { return IR::Entity(INCREMENT, e[1].primaryArg()); } },
+            // LOAD_SYMBOL a
+            // LOAD_CONST n (1)
+            // ADD / SUB
+            // ---> INCREMENT / DECREMENT a
+            { .pattern = { LOAD_SYMBOL, LOAD_CONST, ADD },
+              .condition = [](const IROptimizer& self, const Entities e) { return self.isNumber(e[1].primaryArg(), 1); },
+              .replacement = [](const Entities e) { return IR::Entity(INCREMENT, e[0].primaryArg()); } },
+            { .pattern = { LOAD_SYMBOL, LOAD_CONST, SUB },
+              .condition = [](const IROptimizer& self, const Entities e) { return self.isNumber(e[1].primaryArg(), 1); },
+              .replacement = [](const Entities e) { return IR::Entity(DECREMENT, e[0].primaryArg()); } },
+            // LOAD_SYMBOL list
+            // TAIL / HEAD
+            // STORE / SET_VAL a
+            // ---> STORE_TAIL list a ; STORE_HEAD ; SET_VAL_TAIL ; SET_VAL_HEAD
+            { .pattern = { LOAD_SYMBOL, TAIL, STORE },
+              .replacement = [](const Entities e) { return IR::Entity(STORE_TAIL, e[0].primaryArg(), e[2].primaryArg()); } },
+            { .pattern = { LOAD_SYMBOL, TAIL, SET_VAL },
+              .replacement = [](const Entities e) { return IR::Entity(SET_VAL_TAIL, e[0].primaryArg(), e[2].primaryArg()); } },
+            { .pattern = { LOAD_SYMBOL, HEAD, STORE },
+              .replacement = [](const Entities e) { return IR::Entity(STORE_HEAD, e[0].primaryArg(), e[2].primaryArg()); } },
+            { .pattern = { LOAD_SYMBOL, HEAD, SET_VAL },
+              .replacement = [](const Entities e) { return IR::Entity(SET_VAL_HEAD, e[0].primaryArg(), e[2].primaryArg()); } },
+            // LOAD_SYMBOL a
+            // LOAD_CONST n
+            // ADD
+            // ---> LOAD_SYMBOL_LOAD_CONST_ADD a n
+            { .pattern = { LOAD_SYMBOL, LOAD_CONST, ADD },
+              .replacement = [](const Entities e) { return IR::Entity(LOAD_SYMBOL_LOAD_CONST_ADD, e[0].primaryArg(), e[1].primaryArg()); } },
+            // LOAD_CONST x
+            // LOAD_CONST y
+            // ---> LOAD_CONST_LOAD_CONST x y
+            { .pattern = { LOAD_CONST, LOAD_CONST },
+              .replacement = [](const Entities e) { return IR::Entity(LOAD_CONST_LOAD_CONST, e[0].primaryArg(), e[1].primaryArg()); } },
+            // LOAD_CONST x
+            // STORE / SET_VAL a
+            // ---> LOAD_CONST_STORE x a ; LOAD_CONST_SET_VAL x a
+            { .pattern = { LOAD_CONST, STORE },
+              .replacement = [](const Entities e) { return IR::Entity(LOAD_CONST_STORE, e[0].primaryArg(), e[1].primaryArg()); } },
+            { .pattern = { LOAD_CONST, SET_VAL },
+              .replacement = [](const Entities e) { return IR::Entity(LOAD_CONST_SET_VAL, e[0].primaryArg(), e[1].primaryArg()); } },
+            // LOAD_SYMBOL a
+            // STORE / SET_VAL b
+            // ---> STORE_FROM a b ; SET_VAL_FROM a b
+            { .pattern = { LOAD_SYMBOL, STORE },
+              .replacement = [](const Entities e) { return IR::Entity(STORE_FROM, e[0].primaryArg(), e[1].primaryArg()); } },
+            { .pattern = { LOAD_SYMBOL, SET_VAL },
+              .replacement = [](const Entities e) { return IR::Entity(SET_VAL_FROM, e[0].primaryArg(), e[1].primaryArg()); } },
+            // BUILTIN i
+            // CALL n
+            // ---> CALL_BUILTIN i n
+            { .pattern = { BUILTIN, CALL },
+              .condition = [](const IROptimizer&, const Entities e) { return Builtins::builtins[e[0].primaryArg()].second.isFunction(); },
+              .replacement = [](const Entities e) { return IR::Entity(CALL_BUILTIN, e[0].primaryArg(), e[1].primaryArg()); } },
+            // GET_FIELD a
+            // CALL n
+            // ---> GET_FIELD_CALL a n
+            { .pattern = { GET_FIELD, CALL },
+              .replacement = [](const Entities e) { return IR::Entity(GET_FIELD_CALL, e[0].primaryArg(), e[1].primaryArg()); } },
+            // LOAD_SYMBOL a
+            // GET_FIELD b
+            // ---> LOAD_SYMBOL_GET_FIELD a b
+            { .pattern = { LOAD_SYMBOL, GET_FIELD },
+              .replacement = [](const Entities e) { return IR::Entity(LOAD_SYMBOL_GET_FIELD, e[0].primaryArg(), e[1].primaryArg()); } },
+            compare_and_jump(LT, POP_JUMP_IF_TRUE, JUMP_IF_LT),
+            compare_and_jump(LT, POP_JUMP_IF_FALSE, JUMP_IF_GE),
+            compare_and_jump(LE, POP_JUMP_IF_TRUE, JUMP_IF_LE),
+            compare_and_jump(LE, POP_JUMP_IF_FALSE, JUMP_IF_GT),
+            compare_and_jump(GT, POP_JUMP_IF_TRUE, JUMP_IF_GT),
+            compare_and_jump(GT, POP_JUMP_IF_FALSE, JUMP_IF_LE),
+            compare_and_jump(GE, POP_JUMP_IF_TRUE, JUMP_IF_GE),
+            compare_and_jump(GE, POP_JUMP_IF_FALSE, JUMP_IF_LT),
+            compare_and_jump(EQ, POP_JUMP_IF_TRUE, JUMP_IF_EQ),
+            compare_and_jump(EQ, POP_JUMP_IF_FALSE, JUMP_IF_NEQ),
+            compare_and_jump(NEQ, POP_JUMP_IF_TRUE, JUMP_IF_NEQ),
+            compare_and_jump(NEQ, POP_JUMP_IF_FALSE, JUMP_IF_EQ)
+        };
+
+        return table;
     }
 
-    std::optional<IR::Entity> IROptimizer::compactEntities(const IR::Entity& first, const IR::Entity& second, const IR::Entity& third)
+    bool IROptimizer::applyRule(const Rule& rule, IR::Block& block) const
     {
-        if (first.primaryArg() > IR::MaxValueForDualArg || second.primaryArg() > IR::MaxValueForDualArg || third.primaryArg() > IR::MaxValueForDualArg)
-            return std::nullopt;
-
-        // LOAD_SYMBOL a
-        // LOAD_CONST n (1)
-        // ADD / SUB
-        // ---> INCREMENT / DECREMENT a
-        if (third.inst() == ADD && first.inst() == LOAD_CONST && second.inst() == LOAD_SYMBOL && isNumber(first.primaryArg(), 1))
-            return IR::Entity(INCREMENT, second.primaryArg());
-        if (third.inst() == ADD && first.inst() == LOAD_SYMBOL && second.inst() == LOAD_CONST && isNumber(second.primaryArg(), 1))
-            return IR::Entity(INCREMENT, first.primaryArg());
-        if (third.inst() == SUB && first.inst() == LOAD_SYMBOL && second.inst() == LOAD_CONST && isNumber(second.primaryArg(), 1))
-            return IR::Entity(DECREMENT, first.primaryArg());
-        // LOAD_SYMBOL list
-        // TAIL / HEAD
-        // STORE / SET_VAL a
-        // ---> STORE_TAIL list a ; STORE_HEAD ; SET_VAL_TAIL ; SET_VAL_HEAD
-        if (first.inst() == LOAD_SYMBOL && second.inst() == TAIL && third.inst() == STORE)
-            return IR::Entity(STORE_TAIL, first.primaryArg(), third.primaryArg());
-        if (first.inst() == LOAD_SYMBOL && second.inst() == TAIL && third.inst() == SET_VAL)
-            return IR::Entity(SET_VAL_TAIL, first.primaryArg(), third.primaryArg());
-        if (first.inst() == LOAD_SYMBOL && second.inst() == HEAD && third.inst() == STORE)
-            return IR::Entity(STORE_HEAD, first.primaryArg(), third.primaryArg());
-        if (first.inst() == LOAD_SYMBOL && second.inst() == HEAD && third.inst() == SET_VAL)
-            return IR::Entity(SET_VAL_HEAD, first.primaryArg(), third.primaryArg());
-
-        return std::nullopt;
+        const std::size_t size = rule.pattern.size();
+        if (block.size() < size)
+            return false;
+
+        const auto matches = [&](const Entities entities) {
+            for (std::size_t j = 0; j < size; ++j)
+            {
+                // labels have no instruction, they can not be part of a sequence
+                if (entities[j].inst() != rule.pattern[j] || entities[j].primaryArg() > IR::MaxValueForDualArg)
+                    return false;
+            }
+            return !rule.condition || rule.condition(*this, entities);
+        };
+
+        IR::Block result;
+        result.reserve(block.size());
+
+        std::size_t i = 0;
+        const std::size_t end = block.size();
+        while (i < end)
+        {
+            if (i + size <= end)
+            {
+                if (const auto entities = Entities(block).subspan(i, size); matches(entities))
+                {
+                    result.push_back(rule.replacement(entities));
+                    i += size;
+                    continue;
+                }
+            }
+
+            result.push_back(block[i]);
+            ++i;
+        }
+
+        if (result.size() == block.size())
+            return false;
+
+        block = std::move(result);
+        return true;
     }
 
     bool IROptimizer::isNumber(const uint16_t id, const double expected_number) const
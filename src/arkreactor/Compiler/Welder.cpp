@@ -136,6 +136,10 @@ namespace Ark
                         fmt::println(output, "\tGOTO_IF_FALSE L{}", entity.label());
                         break;
 
+                    case internal::IR::Kind::GotoWithInst:
+                        fmt::println(output, "\t{} L{}", internal::InstructionNames[entity.inst()], entity.label());
+                        break;
+
                     case internal::IR::Kind::Opcode:
                         fmt::println(output, "\t{} {}", internal::InstructionNames[entity.inst()], entity.primaryArg());
                         break;
@@ -173,18 +177,19 @@ namespace Ark
                 m_computed_ast = m_macro_processor.ast();
             }
 
-            if ((m_features & FeatureASTOptimizer) != 0)
-            {
-                m_ast_optimizer.process(m_computed_ast);
-                m_computed_ast = m_ast_optimizer.ast();
-            }
-
             if ((m_features & FeatureNameResolver) != 0)
             {
                 // NOTE: ast isn't modified by the name resolver, no need to update m_computed_ast
                 m_name_resolver.process(m_computed_ast);
             }
 
+            // the names are resolved first, so that the errors in the dead code are still reported
+            if ((m_features & FeatureASTOptimizer) != 0)
+            {
+                m_ast_optimizer.process(m_computed_ast);
+                m_computed_ast = m_ast_optimizer.ast();
+            }
+
             return true;
         }
         catch (const CodeError& e)
@@ -0,0 +1,159 @@
+#include <Ark/VM/Coroutine.hpp>
+
+#include <Ark/VM/VM.hpp>
+
+namespace Ark::internal
+{
+    Coroutine::Coroutine(ExecutionContext* context, VM* vm, std::vector<Value>& args) :
+        m_context(context), m_vm(vm), m_args(args), m_frames_count(0), m_started(false), m_joined(nullptr), m_status(Status::Ready)
+    {}
+
+    bool Coroutine::run()
+    {
+        Status expected = Status::Ready;
+        if (!m_status.compare_exchange_strong(expected, Status::Running, std::memory_order_acq_rel))
+            return false;
+
+        {
+            const RunningScope running(this);
+            try
+            {
+                resume();
+            }
+            catch (...)
+            {
+                m_exception = std::current_exception();
+                m_context->yielded = false;
+            }
+        }
+
+        if (m_context->yielded)
+        {
+            m_context->yielded = false;
+
+            // once parked, the coroutine we are waiting for gives us back to the scheduler when it finishes
+            expected = Status::Running;
+            if (m_joined != nullptr && m_status.compare_exchange_strong(expected, Status::Parked, std::memory_order_acq_rel))
+                return true;
+
+            // this can be run by another thread as soon as it is submitted
+            m_status.store(Status::Ready, std::memory_order_release);
+            m_vm->m_scheduler->submit(this, /* yielded= */ m_joined == nullptr);
+            return true;
+        }
+
+        finish();
+        return true;
+    }
+
+    Coroutine* Coroutine::current() noexcept
+    {
+        return dynamic_cast<Coroutine*>(Task::current());
+    }
+
+    void Coroutine::yield() noexcept
+    {
+        m_context->yielded = true;
+    }
+
+    Value Coroutine::join()
+    {
+        if (Coroutine* waiter = current(); waiter != nullptr)
+        {
+            const std::lock_guard lock(m_mutex);
+            if (m_status.load(std::memory_order_acquire) != Status::Finished)
+            {
+                m_waiters.push_back(waiter);
+                waiter->m_joined = this;
+                waiter->m_context->yielded = true;
+                return Nil;
+            }
+        }
+        else
+        {
+            for (Status status = m_status.load(std::memory_order_acquire); status != Status::Finished; status = m_status.load(std::memory_order_acquire))
+            {
+                if (!m_vm->m_scheduler->runPendingTask())
+                    m_status.wait(status, std::memory_order_acquire);
+            }
+        }
+
+        if (m_exception)
+            std::rethrow_exception(m_exception);
+        return m_value;
+    }
+
+    void Coroutine::resume()
+    {
+        if (!m_started)
+        {
+            m_started = true;
+
+            // same as VM::resolve, without waiting for the function to return
+            for (auto it = m_args.begin() + 1, it_end = m_args.end(); it != it_end; ++it)
+                m_vm->push(*it, *m_context);
+            m_vm->push(m_args[0], *m_context);
+
+            m_frames_count = m_context->fc;
+            const auto argc = static_cast<uint16_t>(m_args.size() - 1);
+            m_args.clear();
+            m_vm->call(*m_context, argc);
+        }
+        else if (m_joined != nullptr)
+        {
+            const Coroutine* joined = m_joined;
+            m_joined = nullptr;
+            if (joined->m_exception)
+                std::rethrow_exception(joined->m_exception);
+            // replace the placeholder returned by join
+            m_context->stack[m_context->sp - 1] = joined->m_value;
+        }
+
+        if (m_context->fc > m_frames_count)
+            m_vm->safeRun(*m_context, /* untilFrameCount */ m_frames_count);
+    }
+
+    void Coroutine::finish()
+    {
+        // if an error occurred, the function didn't return
+        if (!m_exception && m_context->fc <= m_frames_count)
+            m_value = *m_vm->popAndResolveAsPtr(*m_context);
+        m_vm->deleteContext(m_context);
+        m_context = nullptr;
+
+        std::vector<Coroutine*> waiters;
+        {
+            const std::lock_guard lock(m_mutex);
+            m_status.store(Status::Finished, std::memory_order_release);
+            waiters.swap(m_waiters);
+        }
+        m_status.notify_all();
+
+        for (Coroutine* waiter : waiters)
+            waiter->wake();
+    }
+
+    void Coroutine::wake()
+    {
+        Status status = m_status.load(std::memory_order_acquire);
+        while (true)
+        {
+            if (status == Status::Parked)
+            {
+                if (m_status.compare_exchange_weak(status, Status::Ready, std::memory_order_acq_rel))
+                {
+                    m_vm->m_scheduler->submit(this);
+                    return;
+                }
+            }
+            // still running: it will be given back to the scheduler instead of being parked
+            else if (status == Status::Running)
+            {
+                if (m_status.compare_exchange_weak(status, Status::Woken, std::memory_order_acq_rel))
+                    return;
+            }
+            else
+                return;
+        }
+    }
+}
@@ -5,22 +5,58 @@
 namespace Ark::internal
 {
     Future::Future(ExecutionContext* context, VM* vm, std::vector<Value>& args) :
-        m_context(context), m_vm(vm), m_value(std::async(std::launch::async, [vm, context, args]() mutable {
-            return vm->resolve(context, args);
-        }))
+        m_context(context), m_vm(vm), m_args(args), m_status(Status::Pending)
     {}
 
+    bool Future::run()
+    {
+        Status expected = Status::Pending;
+        if (!m_status.compare_exchange_strong(expected, Status::Running, std::memory_order_acq_rel))
+            return false;
+
+        {
+            const RunningScope running(this);
+            try
+            {
+                m_value = m_vm->resolve(m_context, m_args);
+            }
+            catch (...)
+            {
+                m_exception = std::current_exception();
+            }
+        }
+        m_args.clear();
+
+        m_status.store(Status::Done, std::memory_order_release);
+        m_status.notify_all();
+        return true;
+    }
+
     Value Future::resolve()
     {
-        if (!m_value.valid())
+        if (m_status.load(std::memory_order_acquire) == Status::Awaited)
             return Nil;
 
-        m_value.wait();
-        Value res = m_value.get();
+        // run the future ourselves if no worker has started it yet, otherwise help
+        // the workers by running the pending futures while waiting for it
+        if (!run())
+        {
+            while (m_status.load(std::memory_order_acquire) == Status::Running)
+            {
+                if (!m_vm->m_scheduler->runPendingTask())
+                    m_status.wait(Status::Running, std::memory_order_acquire);
+            }
+        }
+
+        Status expected = Status::Done;
+        if (!m_status.compare_exchange_strong(expected, Status::Awaited, std::memory_order_acq_rel))
+            return Nil;
 
         m_vm->deleteContext(m_context);
         m_context = nullptr;
 
-        return res;
+        if (m_exception)
+            std::rethrow_exception(m_exception);
+        return std::move(m_value);
     }
 }
@@ -0,0 +1,1302 @@
+#include <Ark/VM/Jit.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <span>
+#include <utility>
+
+#include <Ark/Compiler/Instructions.hpp>
+#include <Ark/Constants.hpp>
+
+#ifdef ARK_ENABLE_JIT
+#    include <sys/mman.h>
+#endif
+
+namespace Ark::internal
+{
+#ifdef ARK_ENABLE_JIT
+    namespace
+    {
+        /**
+         * @brief Parts of a stencil to replace when copying it, with a value known when compiling the page
+         *
+         */
+        enum class HoleKind : uint8_t
+        {
+            Exit,         ///< Address of the code going back to the interpreter at the current instruction
+            Target,       ///< Address of the code of the instruction a jump goes to
+            Value,        ///< First immediate value
+            SecondValue,  ///< Second immediate value
+            Local,        ///< Offset of a slot of the current scope, from the start of the scope
+            Slot,         ///< Index of a slot of the current scope
+            Variable,     ///< Offset of a variable in the table given by the VM
+            Symbol,       ///< Symbol id, saved as the last symbol loaded
+            Ip            ///< Index of the current instruction
+        };
+
+        constexpr std::size_t HoleKindsCount = static_cast<std::size_t>(HoleKind::Ip) + 1;
+
+        struct Hole
+        {
+            uint8_t offset;  ///< Position in the code of the stencil
+            HoleKind kind;
+            uint8_t size;    ///< Number of bytes to write
+            bool relative;   ///< Relative to the address of the hole (rel32 operand of a jump) instead of absolute
+            int8_t addend;   ///< Added to the value
+        };
+
+        /**
+         * @brief Machine code of an instruction, with holes to fill
+         * @details The stencils were written in assembly, following the System V calling convention of JitPage::Function:
+         *          rdi holds the start of the stack, rsi the first free value on the stack, rdx the table of variables,
+         *          rcx the slots of the current scope, r8 the end of the stack, and r9 the JitFrame. The stencils only
+         *          use rax, r10, r11 and xmm0-xmm2 as scratch registers, they don't need to save any register.
+         *          A value is a 4 bytes type followed by a 8 bytes payload, at offset 8. The types of a value are:
+         *          1 Number, 8 True, 9 False, 10 Undefined, 11 Reference. The stencils never overwrite a value of a
+         *          type owning memory (list, string, closure, user type: the bits of the mask 0x65) so that the
+         *          interpreter can release it, and jump to `exit` before writing anything when they can't run the
+         *          instruction themselves.
+         *          They are assembled with `as --64` (Intel syntax), the holes being the relocations of the object file.
+         *
+         */
+        struct Stencil
+        {
+            std::span<const uint8_t> code;
+            std::span<const Hole> holes;
+        };
+
+        // NOP
+        constexpr Stencil Nop {};
+
+        // Go back to the interpreter at the instruction `ip`
+        //      mov qword ptr [r9], rsi
+        //      mov eax, ip
+        //      ret
+        constexpr uint8_t ExitCode[] = {
+            0x49, 0x89, 0x31, 0xb8, 0x00, 0x00, 0x00, 0x00, 0xc3
+        };
+        constexpr Hole ExitHoles[] = { { 4, HoleKind::Ip, 4, false, 0 } };
+        constexpr Stencil Exit { ExitCode, ExitHoles };
+
+        // LOAD_CONST: push a reference to the constant `value`
+        //      cmp rsi, r8
+        //      jae exit
+        //      mov eax, dword ptr [rsi]
+        //      mov r10d, 0x65
+        //      bt r10d, eax
+        //      jc exit
+        //      mov dword ptr [rsi], 11
+        //      movabs rax, value
+        //      mov qword ptr [rsi + 8], rax
+        //      add rsi, 16
+        constexpr uint8_t LoadConstCode[] = {
+            0x4c, 0x39, 0xc6, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x06, 0x41, 0xba, 0x65, 0x00, 0x00,
+            0x00, 0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0xc7, 0x06, 0x0b, 0x00, 0x00,
+            0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0x46, 0x08, 0x48,
+            0x83, 0xc6, 0x10
+        };
+        constexpr Hole LoadConstHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 23, HoleKind::Exit, 4, true, -4 }, { 35, HoleKind::Value, 8, false, 0 } };
+        constexpr Stencil LoadConst { LoadConstCode, LoadConstHoles };
+
+        // LOAD_CONST_LOAD_CONST: push a reference to the constants `value` and `second_value`
+        //      lea rax, [rsi + 32]
+        //      cmp rax, r8
+        //      ja exit
+        //      mov eax, dword ptr [rsi]
+        //      mov r10d, 0x65
+        //      bt r10d, eax
+        //      jc exit
+        //      mov eax, dword ptr [rsi + 16]
+        //      bt r10d, eax
+        //      jc exit
+        //      mov dword ptr [rsi], 11
+        //      movabs rax, value
+        //      mov qword ptr [rsi + 8], rax
+        //      mov dword ptr [rsi + 16], 11
+        //      movabs rax, second_value
+        //      mov qword ptr [rsi + 24], rax
+        //      add rsi, 32
+        constexpr uint8_t LoadConstLoadConstCode[] = {
+            0x48, 0x8d, 0x46, 0x20, 0x4c, 0x39, 0xc0, 0x0f, 0x87, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x06, 0x41,
+            0xba, 0x65, 0x00, 0x00, 0x00, 0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x8b,
+            0x46, 0x10, 0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0xc7, 0x06, 0x0b, 0x00,
+            0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0x46, 0x08,
+            0xc7, 0x46, 0x10, 0x0b, 0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x48, 0x89, 0x46, 0x18, 0x48, 0x83, 0xc6, 0x20
+        };
+        constexpr Hole LoadConstLoadConstHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 27, HoleKind::Exit, 4, true, -4 }, { 40, HoleKind::Exit, 4, true, -4 }, { 52, HoleKind::Value, 8, false, 0 }, { 73, HoleKind::SecondValue, 8, false, 0 } };
+        constexpr Stencil LoadConstLoadConst { LoadConstLoadConstCode, LoadConstLoadConstHoles };
+
+        // LOAD_LOCAL: push a reference to the value in the slot `slot` of the current scope, at `local` bytes from its start
+        //      cmp qword ptr [r9 + 16], slot
+        //      jbe exit
+        //      cmp rsi, r8
+        //      jae exit
+        //      mov eax, dword ptr [rsi]
+        //      mov r10d, 0x65
+        //      bt r10d, eax
+        //      jc exit
+        //      lea r11, [rcx + local + 8]
+        //      cmp dword ptr [r11], 10
+        //      je exit
+        //      cmp dword ptr [r11], 11
+        //      jne 1f
+        //      mov r11, qword ptr [r11 + 8]
+        // 1:
+        //      movzx eax, word ptr [rcx + local]
+        //      mov word ptr [r9 + 8], ax
+        //      mov dword ptr [rsi], 11
+        //      mov qword ptr [rsi + 8], r11
+        //      add rsi, 16
+        constexpr uint8_t LoadLocalCode[] = {
+            0x49, 0x81, 0x79, 0x10, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x39,
+            0xc6, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x06, 0x41, 0xba, 0x65, 0x00, 0x00, 0x00, 0x41,
+            0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x99, 0x00, 0x00, 0x00, 0x00,
+            0x41, 0x83, 0x3b, 0x0a, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04,
+            0x4d, 0x8b, 0x5b, 0x08, 0x0f, 0xb7, 0x81, 0x00, 0x00, 0x00, 0x00, 0x66, 0x41, 0x89, 0x41, 0x08,
+            0xc7, 0x06, 0x0b, 0x00, 0x00, 0x00, 0x4c, 0x89, 0x5e, 0x08, 0x48, 0x83, 0xc6, 0x10
+        };
+        constexpr Hole LoadLocalHoles[] = { { 4, HoleKind::Slot, 4, false, 0 }, { 10, HoleKind::Exit, 4, true, -4 }, { 19, HoleKind::Exit, 4, true, -4 }, { 37, HoleKind::Exit, 4, true, -4 }, { 44, HoleKind::Local, 4, false, 8 }, { 54, HoleKind::Exit, 4, true, -4 }, { 71, HoleKind::Local, 4, false, 0 } };
+        constexpr Stencil LoadLocal { LoadLocalCode, LoadLocalHoles };
+
+        // LOAD_SYMBOL, GLOBAL_LOAD: push a reference to a variable found by the VM
+        //      cmp rsi, r8
+        //      jae exit
+        //      mov eax, dword ptr [rsi]
+        //      mov r10d, 0x65
+        //      bt r10d, eax
+        //      jc exit
+        //      mov r11, qword ptr [rdx + variable]
+        //      test r11, r11
+        //      jz exit
+        //      mov word ptr [r9 + 8], symbol
+        //      mov dword ptr [rsi], 11
+        //      mov qword ptr [rsi + 8], r11
+        //      add rsi, 16
+        constexpr uint8_t LoadVariableCode[] = {
+            0x4c, 0x39, 0xc6, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x06, 0x41, 0xba, 0x65, 0x00, 0x00,
+            0x00, 0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8b, 0x9a, 0x00, 0x00,
+            0x00, 0x00, 0x4d, 0x85, 0xdb, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x66, 0x41, 0xc7, 0x41, 0x08,
+            0x00, 0x00, 0xc7, 0x06, 0x0b, 0x00, 0x00, 0x00, 0x4c, 0x89, 0x5e, 0x08, 0x48, 0x83, 0xc6, 0x10
+        };
+        constexpr Hole LoadVariableHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 23, HoleKind::Exit, 4, true, -4 }, { 30, HoleKind::Variable, 4, false, 0 }, { 39, HoleKind::Exit, 4, true, -4 }, { 48, HoleKind::Symbol, 2, false, 0 } };
+        constexpr Stencil LoadVariable { LoadVariableCode, LoadVariableHoles };
+
+        // STORE_LOCAL: pop a number in the slot `slot` of the current scope, if it isn't a deleted argument (undefined)
+        //      cmp rsi, rdi
+        //      jbe exit
+        //      cmp qword ptr [r9 + 16], slot
+        //      jbe exit
+        //      lea r11, [rcx + local + 8]
+        //      cmp dword ptr [r11], 11
+        //      jne 1f
+        //      mov r11, qword ptr [r11 + 8]
+        // 1:
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 2f
+        //      mov r10, qword ptr [r10 + 8]
+        // 2:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r10 + 8]
+        //      mov eax, dword ptr [r11]
+        //      mov r10d, 0xc65
+        //      bt r10d, eax
+        //      jc exit
+        //      mov dword ptr [r11], 1
+        //      movsd qword ptr [r11 + 8], xmm0
+        //      sub rsi, 16
+        constexpr uint8_t StoreLocalCode[] = {
+            0x48, 0x39, 0xfe, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00, 0x49, 0x81, 0x79, 0x10, 0x00, 0x00, 0x00,
+            0x00, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x99, 0x00, 0x00, 0x00, 0x00, 0x41, 0x83,
+            0x3b, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x5b, 0x08, 0x4c, 0x8d, 0x56, 0xf0, 0x41, 0x83, 0x3a, 0x0b,
+            0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00,
+            0xf2, 0x41, 0x0f, 0x10, 0x42, 0x08, 0x41, 0x8b, 0x03, 0x41, 0xba, 0x65, 0x0c, 0x00, 0x00, 0x41,
+            0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x41, 0xc7, 0x03, 0x01, 0x00, 0x00, 0x00,
+            0xf2, 0x41, 0x0f, 0x11, 0x43, 0x08, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole StoreLocalHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 13, HoleKind::Slot, 4, false, 0 }, { 19, HoleKind::Exit, 4, true, -4 }, { 26, HoleKind::Local, 4, false, 8 }, { 60, HoleKind::Exit, 4, true, -4 }, { 85, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil StoreLocal { StoreLocalCode, StoreLocalHoles };
+
+        // SET_VAL, GLOBAL_STORE: pop a number in a variable found by the VM
+        //      cmp rsi, rdi
+        //      jbe exit
+        //      mov r11, qword ptr [rdx + variable]
+        //      test r11, r11
+        //      jz exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 2f
+        //      mov r10, qword ptr [r10 + 8]
+        // 2:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r10 + 8]
+        //      mov eax, dword ptr [r11]
+        //      mov r10d, 0x865
+        //      bt r10d, eax
+        //      jc exit
+        //      mov dword ptr [r11], 1
+        //      movsd qword ptr [r11 + 8], xmm0
+        //      sub rsi, 16
+        constexpr uint8_t StoreVariableCode[] = {
+            0x48, 0x39, 0xfe, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8b, 0x9a, 0x00, 0x00, 0x00, 0x00,
+            0x4d, 0x85, 0xdb, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56, 0xf0, 0x41, 0x83, 0x3a,
+            0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00,
+            0x00, 0xf2, 0x41, 0x0f, 0x10, 0x42, 0x08, 0x41, 0x8b, 0x03, 0x41, 0xba, 0x65, 0x08, 0x00, 0x00,
+            0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x41, 0xc7, 0x03, 0x01, 0x00, 0x00,
+            0x00, 0xf2, 0x41, 0x0f, 0x11, 0x43, 0x08, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole StoreVariableHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 12, HoleKind::Variable, 4, false, 0 }, { 21, HoleKind::Exit, 4, true, -4 }, { 45, HoleKind::Exit, 4, true, -4 }, { 70, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil StoreVariable { StoreVariableCode, StoreVariableHoles };
+
+        // LOAD_CONST_SET_VAL: set a variable found by the VM to the number `value` (its bits)
+        //      mov r11, qword ptr [rdx + variable]
+        //      test r11, r11
+        //      jz exit
+        //      mov eax, dword ptr [r11]
+        //      mov r10d, 0x865
+        //      bt r10d, eax
+        //      jc exit
+        //      mov dword ptr [r11], 1
+        //      movabs rax, value
+        //      mov qword ptr [r11 + 8], rax
+        constexpr uint8_t SetVariableToNumberCode[] = {
+            0x4c, 0x8b, 0x9a, 0x00, 0x00, 0x00, 0x00, 0x4d, 0x85, 0xdb, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00,
+            0x41, 0x8b, 0x03, 0x41, 0xba, 0x65, 0x08, 0x00, 0x00, 0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00,
+            0x00, 0x00, 0x00, 0x41, 0xc7, 0x03, 0x01, 0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x49, 0x89, 0x43, 0x08
+        };
+        constexpr Hole SetVariableToNumberHoles[] = { { 3, HoleKind::Variable, 4, false, 0 }, { 12, HoleKind::Exit, 4, true, -4 }, { 31, HoleKind::Exit, 4, true, -4 }, { 44, HoleKind::Value, 8, false, 0 } };
+        constexpr Stencil SetVariableToNumber { SetVariableToNumberCode, SetVariableToNumberHoles };
+
+        // INCREMENT: push a numeric variable plus 1
+        //      cmp rsi, r8
+        //      jae exit
+        //      mov eax, dword ptr [rsi]
+        //      mov r10d, 0x65
+        //      bt r10d, eax
+        //      jc exit
+        //      mov r11, qword ptr [rdx + variable]
+        //      test r11, r11
+        //      jz exit
+        //      cmp dword ptr [r11], 11
+        //      jne 1f
+        //      mov r11, qword ptr [r11 + 8]
+        // 1:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      mov word ptr [r9 + 8], symbol
+        //      mov eax, 1
+        //      cvtsi2sd xmm1, eax
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      addsd xmm0, xmm1
+        //      mov dword ptr [rsi], 1
+        //      movsd qword ptr [rsi + 8], xmm0
+        //      add rsi, 16
+        constexpr uint8_t IncrementCode[] = {
+            0x4c, 0x39, 0xc6, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x06, 0x41, 0xba, 0x65, 0x00, 0x00,
+            0x00, 0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8b, 0x9a, 0x00, 0x00,
+            0x00, 0x00, 0x4d, 0x85, 0xdb, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x41, 0x83, 0x3b, 0x0b, 0x75,
+            0x04, 0x4d, 0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x66,
+            0x41, 0xc7, 0x41, 0x08, 0x00, 0x00, 0xb8, 0x01, 0x00, 0x00, 0x00, 0xf2, 0x0f, 0x2a, 0xc8, 0xf2,
+            0x41, 0x0f, 0x10, 0x43, 0x08, 0xf2, 0x0f, 0x58, 0xc1, 0xc7, 0x06, 0x01, 0x00, 0x00, 0x00, 0xf2,
+            0x0f, 0x11, 0x46, 0x08, 0x48, 0x83, 0xc6, 0x10
+        };
+        constexpr Hole IncrementHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 23, HoleKind::Exit, 4, true, -4 }, { 30, HoleKind::Variable, 4, false, 0 }, { 39, HoleKind::Exit, 4, true, -4 }, { 59, HoleKind::Exit, 4, true, -4 }, { 68, HoleKind::Symbol, 2, false, 0 } };
+        constexpr Stencil Increment { IncrementCode, IncrementHoles };
+
+        // DECREMENT: push a numeric variable minus 1
+        //      cmp rsi, r8
+        //      jae exit
+        //      mov eax, dword ptr [rsi]
+        //      mov r10d, 0x65
+        //      bt r10d, eax
+        //      jc exit
+        //      mov r11, qword ptr [rdx + variable]
+        //      test r11, r11
+        //      jz exit
+        //      cmp dword ptr [r11], 11
+        //      jne 1f
+        //      mov r11, qword ptr [r11 + 8]
+        // 1:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      mov word ptr [r9 + 8], symbol
+        //      mov eax, 1
+        //      cvtsi2sd xmm1, eax
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      subsd xmm0, xmm1
+        //      mov dword ptr [rsi], 1
+        //      movsd qword ptr [rsi + 8], xmm0
+        //      add rsi, 16
+        constexpr uint8_t DecrementCode[] = {
+            0x4c, 0x39, 0xc6, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x06, 0x41, 0xba, 0x65, 0x00, 0x00,
+            0x00, 0x41, 0x0f, 0xa3, 0xc2, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8b, 0x9a, 0x00, 0x00,
+            0x00, 0x00, 0x4d, 0x85, 0xdb, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x41, 0x83, 0x3b, 0x0b, 0x75,
+            0x04, 0x4d, 0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x66,
+            0x41, 0xc7, 0x41, 0x08, 0x00, 0x00, 0xb8, 0x01, 0x00, 0x00, 0x00, 0xf2, 0x0f, 0x2a, 0xc8, 0xf2,
+            0x41, 0x0f, 0x10, 0x43, 0x08, 0xf2, 0x0f, 0x5c, 0xc1, 0xc7, 0x06, 0x01, 0x00, 0x00, 0x00, 0xf2,
+            0x0f, 0x11, 0x46, 0x08, 0x48, 0x83, 0xc6, 0x10
+        };
+        constexpr Hole DecrementHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 23, HoleKind::Exit, 4, true, -4 }, { 30, HoleKind::Variable, 4, false, 0 }, { 39, HoleKind::Exit, 4, true, -4 }, { 59, HoleKind::Exit, 4, true, -4 }, { 68, HoleKind::Symbol, 2, false, 0 } };
+        constexpr Stencil Decrement { DecrementCode, DecrementHoles };
+
+        // ADD on two numbers
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      addsd xmm0, qword ptr [r10 + 8]
+        //      mov dword ptr [rsi - 32], 1
+        //      movsd qword ptr [rsi - 24], xmm0
+        //      sub rsi, 16
+        constexpr uint8_t AddCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x58, 0x42, 0x08, 0xc7, 0x46, 0xe0, 0x01, 0x00, 0x00, 0x00,
+            0xf2, 0x0f, 0x11, 0x46, 0xe8, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole AddHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Add { AddCode, AddHoles };
+
+        // SUB on two numbers
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      subsd xmm0, qword ptr [r10 + 8]
+        //      mov dword ptr [rsi - 32], 1
+        //      movsd qword ptr [rsi - 24], xmm0
+        //      sub rsi, 16
+        constexpr uint8_t SubCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x5c, 0x42, 0x08, 0xc7, 0x46, 0xe0, 0x01, 0x00, 0x00, 0x00,
+            0xf2, 0x0f, 0x11, 0x46, 0xe8, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole SubHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Sub { SubCode, SubHoles };
+
+        // MUL on two numbers
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      mulsd xmm0, qword ptr [r10 + 8]
+        //      mov dword ptr [rsi - 32], 1
+        //      movsd qword ptr [rsi - 24], xmm0
+        //      sub rsi, 16
+        constexpr uint8_t MulCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x59, 0x42, 0x08, 0xc7, 0x46, 0xe0, 0x01, 0x00, 0x00, 0x00,
+            0xf2, 0x0f, 0x11, 0x46, 0xe8, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole MulHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Mul { MulCode, MulHoles };
+
+        // DIV on two numbers, the division by zero is left to the interpreter
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      xorpd xmm2, xmm2
+        //      ucomisd xmm1, xmm2
+        //      jp 3f
+        //      je exit
+        // 3:
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      divsd xmm0, xmm1
+        //      mov dword ptr [rsi - 32], 1
+        //      movsd qword ptr [rsi - 24], xmm0
+        //      sub rsi, 16
+        constexpr uint8_t DivCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x4a, 0x08, 0x66, 0x0f, 0x57, 0xd2, 0x66, 0x0f, 0x2e, 0xca, 0x7a, 0x06, 0x0f, 0x84, 0x00,
+            0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10, 0x43, 0x08, 0xf2, 0x0f, 0x5e, 0xc1, 0xc7, 0x46, 0xe0,
+            0x01, 0x00, 0x00, 0x00, 0xf2, 0x0f, 0x11, 0x46, 0xe8, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole DivHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 }, { 79, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Div { DivCode, DivHoles };
+
+        // LT on two numbers: a < b, false if one of them is NaN
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      mov eax, 9
+        //      mov r10d, 8
+        //      ucomisd xmm1, xmm0
+        //      cmova eax, r10d
+        //      mov dword ptr [rsi - 32], eax
+        //      mov qword ptr [rsi - 24], 0
+        //      sub rsi, 16
+        constexpr uint8_t LtCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0xb8, 0x09, 0x00, 0x00, 0x00, 0x41, 0xba,
+            0x08, 0x00, 0x00, 0x00, 0x66, 0x0f, 0x2e, 0xc8, 0x41, 0x0f, 0x47, 0xc2, 0x89, 0x46, 0xe0, 0x48,
+            0xc7, 0x46, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole LtHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Lt { LtCode, LtHoles };
+
+        // LE on two numbers: a < b || a == b
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      mov eax, 9
+        //      mov r10d, 8
+        //      ucomisd xmm1, xmm0
+        //      cmovae eax, r10d
+        //      mov dword ptr [rsi - 32], eax
+        //      mov qword ptr [rsi - 24], 0
+        //      sub rsi, 16
+        constexpr uint8_t LeCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0xb8, 0x09, 0x00, 0x00, 0x00, 0x41, 0xba,
+            0x08, 0x00, 0x00, 0x00, 0x66, 0x0f, 0x2e, 0xc8, 0x41, 0x0f, 0x43, 0xc2, 0x89, 0x46, 0xe0, 0x48,
+            0xc7, 0x46, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole LeHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Le { LeCode, LeHoles };
+
+        // GT on two numbers: a != b && !(a < b), true if one of them is NaN
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      mov eax, 9
+        //      mov r10d, 8
+        //      ucomisd xmm1, xmm0
+        //      cmovb eax, r10d
+        //      mov dword ptr [rsi - 32], eax
+        //      mov qword ptr [rsi - 24], 0
+        //      sub rsi, 16
+        constexpr uint8_t GtCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0xb8, 0x09, 0x00, 0x00, 0x00, 0x41, 0xba,
+            0x08, 0x00, 0x00, 0x00, 0x66, 0x0f, 0x2e, 0xc8, 0x41, 0x0f, 0x42, 0xc2, 0x89, 0x46, 0xe0, 0x48,
+            0xc7, 0x46, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole GtHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Gt { GtCode, GtHoles };
+
+        // GE on two numbers: !(a < b), true if one of them is NaN
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      mov eax, 9
+        //      mov r10d, 8
+        //      ucomisd xmm1, xmm0
+        //      cmovbe eax, r10d
+        //      mov dword ptr [rsi - 32], eax
+        //      mov qword ptr [rsi - 24], 0
+        //      sub rsi, 16
+        constexpr uint8_t GeCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0xb8, 0x09, 0x00, 0x00, 0x00, 0x41, 0xba,
+            0x08, 0x00, 0x00, 0x00, 0x66, 0x0f, 0x2e, 0xc8, 0x41, 0x0f, 0x46, 0xc2, 0x89, 0x46, 0xe0, 0x48,
+            0xc7, 0x46, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole GeHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Ge { GeCode, GeHoles };
+
+        // EQ on two numbers
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      mov eax, 9
+        //      mov r10d, 8
+        //      ucomisd xmm0, xmm1
+        //      jp 4f
+        //      cmove eax, r10d
+        // 4:
+        //      mov dword ptr [rsi - 32], eax
+        //      mov qword ptr [rsi - 24], 0
+        //      sub rsi, 16
+        constexpr uint8_t EqCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0xb8, 0x09, 0x00, 0x00, 0x00, 0x41, 0xba,
+            0x08, 0x00, 0x00, 0x00, 0x66, 0x0f, 0x2e, 0xc1, 0x7a, 0x04, 0x41, 0x0f, 0x44, 0xc2, 0x89, 0x46,
+            0xe0, 0x48, 0xc7, 0x46, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole EqHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Eq { EqCode, EqHoles };
+
+        // NEQ on two numbers
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      mov eax, 8
+        //      mov r10d, 9
+        //      ucomisd xmm0, xmm1
+        //      jp 4f
+        //      cmove eax, r10d
+        // 4:
+        //      mov dword ptr [rsi - 32], eax
+        //      mov qword ptr [rsi - 24], 0
+        //      sub rsi, 16
+        constexpr uint8_t NeqCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0xb8, 0x08, 0x00, 0x00, 0x00, 0x41, 0xba,
+            0x09, 0x00, 0x00, 0x00, 0x66, 0x0f, 0x2e, 0xc1, 0x7a, 0x04, 0x41, 0x0f, 0x44, 0xc2, 0x89, 0x46,
+            0xe0, 0x48, 0xc7, 0x46, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole NeqHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Neq { NeqCode, NeqHoles };
+
+        // POP
+        //      cmp rsi, rdi
+        //      jbe exit
+        //      sub rsi, 16
+        constexpr uint8_t PopCode[] = {
+            0x48, 0x39, 0xfe, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10
+        };
+        constexpr Hole PopHoles[] = { { 5, HoleKind::Exit, 4, true, -4 } };
+        constexpr Stencil Pop { PopCode, PopHoles };
+
+        // JUMP
+        //      jmp target
+        constexpr uint8_t JumpCode[] = {
+            0xe9, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole JumpHoles[] = { { 1, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil Jump { JumpCode, JumpHoles };
+
+        // POP_JUMP_IF_TRUE on a boolean
+        //      cmp rsi, rdi
+        //      jbe exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      mov eax, dword ptr [r10]
+        //      cmp eax, 8
+        //      je 2f
+        //      cmp eax, 9
+        //      jne exit
+        //      sub rsi, 16
+        //      jmp 3f
+        // 2:
+        //      sub rsi, 16
+        //      jmp target
+        // 3:
+        constexpr uint8_t PopJumpIfTrueCode[] = {
+            0x48, 0x39, 0xfe, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56, 0xf0, 0x41, 0x83, 0x3a,
+            0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x8b, 0x02, 0x83, 0xf8, 0x08, 0x74, 0x0f, 0x83,
+            0xf8, 0x09, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10, 0xeb, 0x09, 0x48, 0x83,
+            0xee, 0x10, 0xe9, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole PopJumpIfTrueHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 36, HoleKind::Exit, 4, true, -4 }, { 51, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil PopJumpIfTrue { PopJumpIfTrueCode, PopJumpIfTrueHoles };
+
+        // POP_JUMP_IF_FALSE on a boolean
+        //      cmp rsi, rdi
+        //      jbe exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      mov eax, dword ptr [r10]
+        //      cmp eax, 9
+        //      je 2f
+        //      cmp eax, 8
+        //      jne exit
+        //      sub rsi, 16
+        //      jmp 3f
+        // 2:
+        //      sub rsi, 16
+        //      jmp target
+        // 3:
+        constexpr uint8_t PopJumpIfFalseCode[] = {
+            0x48, 0x39, 0xfe, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56, 0xf0, 0x41, 0x83, 0x3a,
+            0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x8b, 0x02, 0x83, 0xf8, 0x09, 0x74, 0x0f, 0x83,
+            0xf8, 0x08, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xee, 0x10, 0xeb, 0x09, 0x48, 0x83,
+            0xee, 0x10, 0xe9, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole PopJumpIfFalseHoles[] = { { 5, HoleKind::Exit, 4, true, -4 }, { 36, HoleKind::Exit, 4, true, -4 }, { 51, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil PopJumpIfFalse { PopJumpIfFalseCode, PopJumpIfFalseHoles };
+
+        // JUMP_IF_LT on two numbers: a < b, false if one of them is NaN
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      lea rsi, [rsi - 32]
+        //      ucomisd xmm1, xmm0
+        //      ja target
+        constexpr uint8_t JumpIfLtCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0x48, 0x8d, 0x76, 0xe0, 0x66, 0x0f, 0x2e,
+            0xc8, 0x0f, 0x87, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole JumpIfLtHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 }, { 83, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil JumpIfLt { JumpIfLtCode, JumpIfLtHoles };
+
+        // JUMP_IF_LE on two numbers: a < b || a == b
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      lea rsi, [rsi - 32]
+        //      ucomisd xmm1, xmm0
+        //      jae target
+        constexpr uint8_t JumpIfLeCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0x48, 0x8d, 0x76, 0xe0, 0x66, 0x0f, 0x2e,
+            0xc8, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole JumpIfLeHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 }, { 83, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil JumpIfLe { JumpIfLeCode, JumpIfLeHoles };
+
+        // JUMP_IF_GT on two numbers: a != b && !(a < b), true if one of them is NaN
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      lea rsi, [rsi - 32]
+        //      ucomisd xmm1, xmm0
+        //      jb target
+        constexpr uint8_t JumpIfGtCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0x48, 0x8d, 0x76, 0xe0, 0x66, 0x0f, 0x2e,
+            0xc8, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole JumpIfGtHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 }, { 83, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil JumpIfGt { JumpIfGtCode, JumpIfGtHoles };
+
+        // JUMP_IF_GE on two numbers: !(a < b), true if one of them is NaN
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      lea rsi, [rsi - 32]
+        //      ucomisd xmm1, xmm0
+        //      jbe target
+        constexpr uint8_t JumpIfGeCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0x48, 0x8d, 0x76, 0xe0, 0x66, 0x0f, 0x2e,
+            0xc8, 0x0f, 0x86, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole JumpIfGeHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 }, { 83, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil JumpIfGe { JumpIfGeCode, JumpIfGeHoles };
+
+        // JUMP_IF_EQ on two numbers
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      lea rsi, [rsi - 32]
+        //      ucomisd xmm0, xmm1
+        //      jp 4f
+        //      je target
+        // 4:
+        constexpr uint8_t JumpIfEqCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0x48, 0x8d, 0x76, 0xe0, 0x66, 0x0f, 0x2e,
+            0xc1, 0x7a, 0x06, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole JumpIfEqHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 }, { 85, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil JumpIfEq { JumpIfEqCode, JumpIfEqHoles };
+
+        // JUMP_IF_NEQ on two numbers
+        //      lea rax, [rdi + 32]
+        //      cmp rsi, rax
+        //      jb exit
+        //      lea r10, [rsi - 16]
+        //      cmp dword ptr [r10], 11
+        //      jne 1f
+        //      mov r10, qword ptr [r10 + 8]
+        // 1:
+        //      cmp dword ptr [r10], 1
+        //      jne exit
+        //      lea r11, [rsi - 32]
+        //      cmp dword ptr [r11], 11
+        //      jne 2f
+        //      mov r11, qword ptr [r11 + 8]
+        // 2:
+        //      cmp dword ptr [r11], 1
+        //      jne exit
+        //      movsd xmm0, qword ptr [r11 + 8]
+        //      movsd xmm1, qword ptr [r10 + 8]
+        //      lea rsi, [rsi - 32]
+        //      ucomisd xmm0, xmm1
+        //      jp target
+        //      jne target
+        constexpr uint8_t JumpIfNeqCode[] = {
+            0x48, 0x8d, 0x47, 0x20, 0x48, 0x39, 0xc6, 0x0f, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x56,
+            0xf0, 0x41, 0x83, 0x3a, 0x0b, 0x75, 0x04, 0x4d, 0x8b, 0x52, 0x08, 0x41, 0x83, 0x3a, 0x01, 0x0f,
+            0x85, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x8d, 0x5e, 0xe0, 0x41, 0x83, 0x3b, 0x0b, 0x75, 0x04, 0x4d,
+            0x8b, 0x5b, 0x08, 0x41, 0x83, 0x3b, 0x01, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f,
+            0x10, 0x43, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x4a, 0x08, 0x48, 0x8d, 0x76, 0xe0, 0x66, 0x0f, 0x2e,
+            0xc1, 0x0f, 0x8a, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00
+        };
+        constexpr Hole JumpIfNeqHoles[] = { { 9, HoleKind::Exit, 4, true, -4 }, { 33, HoleKind::Exit, 4, true, -4 }, { 57, HoleKind::Exit, 4, true, -4 }, { 83, HoleKind::Target, 4, true, -4 }, { 89, HoleKind::Target, 4, true, -4 } };
+        constexpr Stencil JumpIfNeq { JumpIfNeqCode, JumpIfNeqHoles };
+
+        using HoleValues = std::array<uint64_t, HoleKindsCount>;
+
+        /**
+         * @brief Stencil chosen for an instruction, with the values of its holes
+         *
+         */
+        struct Block
+        {
+            const Stencil* stencil = nullptr;  ///< nullptr if the instruction isn't supported, its code goes back to the interpreter
+            HoleValues values {};
+            bool jump = false;  ///< true if the instruction jumps to the instruction of its argument
+        };
+
+        void set(HoleValues& values, HoleKind kind, const uint64_t value)
+        {
+            values[static_cast<std::size_t>(kind)] = value;
+        }
+
+        void copyAndPatch(uint8_t* code, const Stencil& stencil, const HoleValues& values)
+        {
+            if (stencil.code.empty())
+                return;
+
+            std::memcpy(code, stencil.code.data(), stencil.code.size());
+            for (const Hole& hole : stencil.holes)
+            {
+                uint8_t* at = code + hole.offset;
+                uint64_t value = values[static_cast<std::size_t>(hole.kind)];
+                if (hole.relative)
+                    value -= reinterpret_cast<std::uintptr_t>(at);
+                value += static_cast<uint64_t>(static_cast<int64_t>(hole.addend));
+                // x86-64 is little endian, the low bytes come first
+                std::memcpy(at, &value, hole.size);
+            }
+        }
+
+        const Stencil* compareJump(const uint8_t inst)
+        {
+            switch (inst)
+            {
+                case JUMP_IF_LT: return &JumpIfLt;
+                case JUMP_IF_LE: return &JumpIfLe;
+                case JUMP_IF_GT: return &JumpIfGt;
+                case JUMP_IF_GE: return &JumpIfGe;
+                case JUMP_IF_EQ: return &JumpIfEq;
+                case JUMP_IF_NEQ: return &JumpIfNeq;
+                default: return nullptr;
+            }
+        }
+    }
+#endif
+
+    JitPage::JitPage() noexcept :
+        m_code(nullptr), m_size(0)
+    {}
+
+    JitPage::~JitPage()
+    {
+#ifdef ARK_ENABLE_JIT
+        if (m_code != nullptr)
+            munmap(m_code, m_size);
+#endif
+    }
+
+    std::unique_ptr<JitPage> JitPage::compile(const DecodedPage& page [[maybe_unused]], std::vector<Value>& constants [[maybe_unused]])
+    {
+#ifdef ARK_ENABLE_JIT
+        std::unique_ptr<JitPage> jit(new JitPage());
+
+        // variables are found by the VM, by name or in the global scope, each time it enters the native code
+        const auto variable = [&jit](const uint16_t id, const bool global, const bool written) -> uint64_t {
+            std::size_t index = 0;
+            while (index < jit->m_variables.size() && (jit->m_variables[index].id != id || jit->m_variables[index].global != global))
+                ++index;
+            if (index == jit->m_variables.size())
+                jit->m_variables.push_back(JitVariable { .id = id, .global = global, .written = false });
+            jit->m_variables[index].written |= written;
+            return index * sizeof(Value*);
+        };
+        // a slot of a scope is its symbol id (2 bytes), followed by its value at offset 8
+        constexpr std::size_t SlotSize = sizeof(std::pair<uint16_t, Value>);
+        static_assert(SlotSize == 24 && alignof(Value) == 8);
+
+        std::vector<Block> blocks(page.size());
+        for (std::size_t i = 0; i < page.size(); ++i)
+        {
+            const auto& [inst, arg, primary, secondary] = page[i];
+            Block& block = blocks[i];
+
+            switch (inst)
+            {
+                case NOP:
+                    block.stencil = &Nop;
+                    break;
+
+                case LOAD_CONST:
+                    block.stencil = &LoadConst;
+                    set(block.values, HoleKind::Value, reinterpret_cast<std::uintptr_t>(&constants[arg]));
+                    break;
+
+                case LOAD_CONST_LOAD_CONST:
+                    block.stencil = &LoadConstLoadConst;
+                    set(block.values, HoleKind::Value, reinterpret_cast<std::uintptr_t>(&constants[primary]));
+                    set(block.values, HoleKind::SecondValue, reinterpret_cast<std::uintptr_t>(&constants[secondary]));
+                    break;
+
+                case LOAD_LOCAL:
+                case STORE_LOCAL:
+                    block.stencil = inst == LOAD_LOCAL ? &LoadLocal : &StoreLocal;
+                    set(block.values, HoleKind::Local, arg * SlotSize);
+                    set(block.values, HoleKind::Slot, arg);
+                    break;
+
+                case LOAD_SYMBOL:
+                case GLOBAL_LOAD:
+                    block.stencil = &LoadVariable;
+                    set(block.values, HoleKind::Variable, variable(arg, inst == GLOBAL_LOAD, false));
+                    set(block.values, HoleKind::Symbol, arg);
+                    break;
+
+                case SET_VAL:
+                case GLOBAL_STORE:
+                    block.stencil = &StoreVariable;
+                    set(block.values, HoleKind::Variable, variable(arg, inst == GLOBAL_STORE, true));
+                    break;
+
+                case LOAD_CONST_SET_VAL:
+                    // only numbers can be copied without touching a reference count
+                    if (constants[primary].valueType() == ValueType::Number)
+                    {
+                        block.stencil = &SetVariableToNumber;
+                        set(block.values, HoleKind::Value, std::bit_cast<uint64_t>(constants[primary].number()));
+                        set(block.values, HoleKind::Variable, variable(secondary, false, true));
+                    }
+                    break;
+
+                case INCREMENT:
+                case DECREMENT:
+                    block.stencil = inst == INCREMENT ? &Increment : &Decrement;
+                    set(block.values, HoleKind::Variable, variable(primary, false, false));
+                    set(block.values, HoleKind::Symbol, primary);
+                    break;
+
+                case ADD: block.stencil = &Add; break;
+                case SUB: block.stencil = &Sub; break;
+                case MUL: block.stencil = &Mul; break;
+                case DIV: block.stencil = &Div; break;
+                case LT: block.stencil = &Lt; break;
+                case LE: block.stencil = &Le; break;
+                case GT: block.stencil = &Gt; break;
+                case GE: block.stencil = &Ge; break;
+                case EQ: block.stencil = &Eq; break;
+                case NEQ: block.stencil = &Neq; break;
+                case POP: block.stencil = &Pop; break;
+
+                case JUMP:
+                case POP_JUMP_IF_TRUE:
+                case POP_JUMP_IF_FALSE:
+                case JUMP_IF_LT:
+                case JUMP_IF_LE:
+                case JUMP_IF_GT:
+                case JUMP_IF_GE:
+                case JUMP_IF_EQ:
+                case JUMP_IF_NEQ:
+                    if (arg < page.size())
+                    {
+                        block.jump = true;
+                        if (inst == JUMP)
+                            block.stencil = &Jump;
+                        else if (inst == POP_JUMP_IF_TRUE)
+                            block.stencil = &PopJumpIfTrue;
+                        else if (inst == POP_JUMP_IF_FALSE)
+                            block.stencil = &PopJumpIfFalse;
+                        else
+                            block.stencil = compareJump(inst);
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        // the code of the instructions in order, then the code going back to the interpreter for each supported instruction
+        std::size_t size = 0;
+        jit->m_offsets.reserve(page.size() + 1);
+        for (const Block& block : blocks)
+        {
+            jit->m_offsets.push_back(static_cast<uint32_t>(size));
+            size += block.stencil != nullptr ? block.stencil->code.size() : Exit.code.size();
+        }
+        // falling off the page goes back to the interpreter as well
+        jit->m_offsets.push_back(static_cast<uint32_t>(size));
+        size += Exit.code.size();
+
+        std::vector<std::size_t> exits(page.size(), 0);
+        for (std::size_t i = 0; i < page.size(); ++i)
+        {
+            if (blocks[i].stencil != nullptr)
+            {
+                exits[i] = size;
+                size += Exit.code.size();
+            }
+        }
+
+        void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+            return nullptr;
+        jit->m_code = static_cast<uint8_t*>(memory);
+        jit->m_size = size;
+
+        const auto address = [&jit](const std::size_t offset) {
+            return static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(jit->m_code + offset));
+        };
+        const auto exitTo = [&jit](const std::size_t offset, const std::size_t ip) {
+            HoleValues values {};
+            set(values, HoleKind::Ip, ip);
+            copyAndPatch(jit->m_code + offset, Exit, values);
+        };
+
+        for (std::size_t i = 0; i < page.size(); ++i)
+        {
+            Block& block = blocks[i];
+            if (block.stencil == nullptr)
+            {
+                exitTo(jit->m_offsets[i], i);
+                continue;
+            }
+
+            set(block.values, HoleKind::Exit, address(exits[i]));
+            if (block.jump)
+                set(block.values, HoleKind::Target, address(jit->m_offsets[page[i].arg]));
+            copyAndPatch(jit->m_code + jit->m_offsets[i], *block.stencil, block.values);
+            exitTo(exits[i], i);
+        }
+        exitTo(jit->m_offsets[page.size()], page.size());
+
+        if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0)
+            return nullptr;
+
+        // a loop runs in native code only if it doesn't go back to the interpreter at each iteration
+        jit->m_native_loops.resize(page.size(), false);
+        for (std::size_t i = 0; i < page.size(); ++i)
+        {
+            if (page[i].inst == JUMP && page[i].arg <= i)
+                jit->m_native_loops[i] = std::all_of(blocks.begin() + page[i].arg, blocks.begin() + static_cast<std::ptrdiff_t>(i) + 1, [](const Block& block) {
+                    return block.stencil != nullptr;
+                });
+        }
+
+        return jit;
+#else
+        return nullptr;
+#endif
+    }
+
+    JitPage::Function JitPage::entry(const std::size_t ip) const noexcept
+    {
+        return reinterpret_cast<Function>(m_code + m_offsets[ip]);
+    }
+
+    Jit::Jit(const ExecutionContext& context) noexcept :
+        m_context(&context)
+    {}
+
+    bool Jit::isAvailable() noexcept
+    {
+#ifdef ARK_ENABLE_JIT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    JitPage* Jit::hotPage(const std::vector<DecodedPage>& pages, const std::size_t pp, std::vector<Value>& constants)
+    {
+        if (m_pages.size() != pages.size()) [[unlikely]]
+            m_pages.resize(pages.size());
+
+        PageState& state = m_pages[pp];
+        if (!state.compiled && ++state.jumps >= JitHotLoopThreshold)
+        {
+            state.compiled = true;
+            state.code = JitPage::compile(pages[pp], constants);
+        }
+        return state.code.get();
+    }
+
+    void Jit::reset() noexcept
+    {
+        m_pages.clear();
+    }
+}
@@ -0,0 +1,151 @@
+#include <Ark/VM/Scheduler.hpp>
+
+#include <algorithm>
+
+namespace Ark::internal
+{
+    namespace
+    {
+        // scheduler and queue index of the worker running on the current thread, if any
+        thread_local const Scheduler* current_scheduler = nullptr;
+        thread_local std::size_t current_queue = 0;
+        // task running on the current thread, if any
+        thread_local Task* current_task = nullptr;
+    }
+
+    Task* Task::current() noexcept
+    {
+        return current_task;
+    }
+
+    Task::RunningScope::RunningScope(Task* task) noexcept :
+        m_previous(current_task)
+    {
+        current_task = task;
+    }
+
+    Task::RunningScope::~RunningScope()
+    {
+        current_task = m_previous;
+    }
+
+    Scheduler::Scheduler(const std::size_t workers_count) :
+        m_pending(0), m_next_queue(0), m_stop(false)
+    {
+        const std::size_t count = std::max<std::size_t>(workers_count, 1);
+
+        m_queues.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+
+        m_workers.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            m_workers.emplace_back(&Scheduler::work, this, i);
+    }
+
+    Scheduler::~Scheduler()
+    {
+        {
+            const std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake_up.notify_all();
+
+        for (auto& worker : m_workers)
+            worker.join();
+    }
+
+    void Scheduler::submit(Task* task, const bool yielded)
+    {
+        const std::size_t index = current_scheduler == this
+            ? current_queue
+            : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+        {
+            // taking the lock so that a worker can not miss the notification between its check and its wait.
+            // the counter is incremented first so that it never goes below 0 when the task is taken
+            const std::lock_guard lock(m_mutex);
+            m_pending.fetch_add(1, std::memory_order_release);
+        }
+
+        {
+            // the workers run the back of their queue first
+            const std::lock_guard lock(m_queues[index]->mutex);
+            if (yielded)
+                m_queues[index]->tasks.push_front(task);
+            else
+                m_queues[index]->tasks.push_back(task);
+        }
+        m_wake_up.notify_one();
+    }
+
+    bool Scheduler::runPendingTask()
+    {
+        const std::size_t index = current_scheduler == this ? current_queue : 0;
+        if (Task* task = take(index); task != nullptr)
+        {
+            task->run();
+            return true;
+        }
+        return false;
+    }
+
+    Task* Scheduler::take(const std::size_t index)
+    {
+        if (m_pending.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        // the most recent task of our own queue is likely to be the one we will await
+        {
+            WorkerQueue& queue = *m_queues[index];
+            const std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                Task* task = queue.tasks.back();
+                queue.tasks.pop_back();
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        // steal the oldest task of another queue
+        for (std::size_t i = 1, count = m_queues.size(); i < count; ++i)
+        {
+            WorkerQueue& queue = *m_queues[(index + i) % count];
+            const std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                Task* task = queue.tasks.front();
+                queue.tasks.pop_front();
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void Scheduler::work(const std::size_t index)
+    {
+        current_scheduler = this;
+        current_queue = index;
+
+        while (true)
+        {
+            if (Task* task = take(index); task != nullptr)
+            {
+                // does nothing if the task has already been started by a thread waiting for it
+                task->run();
+                continue;
+            }
+
+            std::unique_lock lock(m_mutex);
+            m_wake_up.wait(lock, [this] {
+                return m_stop || m_pending.load(std::memory_order_acquire) > 0;
+            });
+            // finish the queued tasks before stopping, as they could have side effects
+            if (m_stop && m_pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+}
@@ -1,24 +1,37 @@
 #include <Ark/VM/Scope.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <cstdint>
 
 namespace Ark::internal
 {
     Scope::Scope() noexcept :
-        m_min_id(std::numeric_limits<uint16_t>::max()), m_max_id(0)
+        m_modified(false), m_min_id(std::numeric_limits<uint16_t>::max()), m_max_id(0)
     {
         m_data.reserve(3);
     }
 
-    void Scope::mergeRefInto(Scope& other)
+    Scope::Scope(Storage&& storage) noexcept :
+        m_data(std::move(storage)), m_modified(false), m_min_id(std::numeric_limits<uint16_t>::max()), m_max_id(0)
+    {}
+
+    Scope::Scope(const std::size_t symbols_count) noexcept :
+        m_index(symbols_count, 0),
+        m_modified_chunks((symbols_count + SnapshotChunkSize - 1) / SnapshotChunkSize, 1),
+        m_modified(true),
+        m_min_id(std::numeric_limits<uint16_t>::max()),
+        m_max_id(0)
     {
-        for (auto& [id, val] : m_data)
-        {
-            if (val.valueType() == ValueType::Reference)
-                other.push_back(id, val);
-            else
-                other.push_back(id, Value(&val));
-        }
+        m_data.reserve(symbols_count);
+    }
+
+    Scope::Storage Scope::releaseStorage() noexcept
+    {
+        m_data.clear();
+        m_min_id = std::numeric_limits<uint16_t>::max();
+        m_max_id = 0;
+        return std::move(m_data);
     }
 
     void Scope::push_back(uint16_t id, Value&& val) noexcept
@@ -28,6 +41,19 @@ namespace Ark::internal
         if (id > m_max_id)
             m_max_id = id;
 
+        if (!m_index.empty())
+        {
+            if (id >= m_index.size())
+            {
+                m_index.resize(id + 1u, 0);
+                m_modified_chunks.resize(id / SnapshotChunkSize + 1u, 1);
+            }
+            // keep the first value pushed with a given id, as a linear search would
+            if (m_index[id] == 0)
+                m_index[id] = static_cast<uint32_t>(m_data.size() + 1);
+            markModified(id);
+        }
+
         m_data.emplace_back(id, std::move(val));
     }
 
@@ -38,9 +64,47 @@ namespace Ark::internal
         if (id > m_max_id)
             m_max_id = id;
 
+        if (!m_index.empty())
+        {
+            if (id >= m_index.size())
+            {
+                m_index.resize(id + 1u, 0);
+                m_modified_chunks.resize(id / SnapshotChunkSize + 1u, 1);
+            }
+            // keep the first value pushed with a given id, as a linear search would
+            if (m_index[id] == 0)
+                m_index[id] = static_cast<uint32_t>(m_data.size() + 1);
+            markModified(id);
+        }
+
         m_data.emplace_back(id, val);
     }
 
+    void Scope::markModified(const Value* value) noexcept
+    {
+        if (m_modified_chunks.empty() || m_data.empty())
+            return;
+
+        // find the position of the value in m_data from its address
+        const auto first = reinterpret_cast<std::uintptr_t>(&m_data.front().second);
+        const auto address = reinterpret_cast<std::uintptr_t>(value);
+        if (address < first)
+            return;
+
+        const std::size_t offset = address - first;
+        if (offset % sizeof(decltype(m_data)::value_type) == 0)
+        {
+            if (const std::size_t i = offset / sizeof(decltype(m_data)::value_type); i < m_data.size())
+                markModified(m_data[i].first);
+        }
+    }
+
+    void Scope::resetModified() noexcept
+    {
+        std::ranges::fill(m_modified_chunks, 0);
+        m_modified = false;
+    }
+
     bool Scope::has(const uint16_t id) noexcept
     {
         return m_min_id <= id && id <= m_max_id && operator[](id) != nullptr;
@@ -48,6 +112,9 @@ namespace Ark::internal
 
     Value* Scope::operator[](const uint16_t id_to_look_for) noexcept
     {
+        if (!m_index.empty())
+            return fromIndex(id_to_look_for);
+
         for (auto& [id, value] : m_data)
         {
             if (id == id_to_look_for)
@@ -58,6 +125,13 @@ namespace Ark::internal
 
     const Value* Scope::operator[](const uint16_t id_to_look_for) const noexcept
     {
+        if (!m_index.empty())
+        {
+            if (id_to_look_for < m_index.size() && m_index[id_to_look_for] != 0)
+                return &m_data[m_index[id_to_look_for] - 1].second;
+            return nullptr;
+        }
+
         for (const auto& [id, value] : m_data)
         {
             if (id == id_to_look_for)
@@ -81,6 +155,50 @@ namespace Ark::internal
         return m_data.size();
     }
 
+    ScopeSnapshot::ScopeSnapshot(Scope& scope, const ScopeSnapshot* previous)
+    {
+        m_chunks.resize(scope.m_modified_chunks.size());
+
+        for (std::size_t i = 0, end = m_chunks.size(); i < end; ++i)
+        {
+            if (previous != nullptr && i < previous->m_chunks.size() && scope.m_modified_chunks[i] == 0)
+            {
+                m_chunks[i] = previous->m_chunks[i];
+                continue;
+            }
+
+            // the values which were never loaded in the scope are kept from the previous snapshot
+            auto chunk = previous != nullptr && i < previous->m_chunks.size()
+                ? std::make_shared<Chunk>(*previous->m_chunks[i])
+                : std::make_shared<Chunk>();
+            for (std::size_t j = 0; j < Scope::SnapshotChunkSize; ++j)
+            {
+                const std::size_t id = i * Scope::SnapshotChunkSize + j;
+                if (id >= scope.m_index.size() || scope.m_index[id] == 0)
+                    continue;
+
+                // the snapshot must not point into the scope, which keeps being modified
+                const Value& val = scope.m_data[scope.m_index[id] - 1].second;
+                chunk->values[j] = val.valueType() == ValueType::Reference ? *val.reference() : val;
+                chunk->bound |= uint64_t(1) << j;
+            }
+            m_chunks[i] = std::move(chunk);
+            scope.m_modified_chunks[i] = 0;
+        }
+
+        scope.m_modified = false;
+    }
+
+    const Value* ScopeSnapshot::operator[](const uint16_t id) const noexcept
+    {
+        const std::size_t chunk = id / Scope::SnapshotChunkSize;
+        const std::size_t pos = id % Scope::SnapshotChunkSize;
+
+        if (chunk < m_chunks.size() && (m_chunks[chunk]->bound & (uint64_t(1) << pos)) != 0)
+            return &m_chunks[chunk]->values[pos];
+        return nullptr;
+    }
+
     bool operator==(const Scope& A, const Scope& B) noexcept
     {
         const std::size_t size = A.size();
@@ -1,5 +1,7 @@
 #include <Ark/VM/State.hpp>
 
+#include <algorithm>
+
 #include <Ark/Constants.hpp>
 #include <Ark/Files.hpp>
 #include <Ark/Compiler/Welder.hpp>
@@ -19,7 +21,10 @@ namespace Ark
     State::State(const std::vector<std::filesystem::path>& libenv) noexcept :
         m_debug_level(0),
         m_libenv(libenv),
-        m_filename(ARK_NO_NAME_FILE)
+        m_filename(ARK_NO_NAME_FILE),
+        m_stack_initial_size(VMStackInitialSize),
+        m_stack_max_size(VMStackMaxSize),
+        m_workers_count(0)
     {}
 
     bool State::feed(const std::string& bytecode_filename)
@@ -139,6 +144,17 @@ namespace Ark
         m_libenv = libenv;
     }
 
+    void State::setStackSize(const std::size_t initial_size, const std::size_t max_size) noexcept
+    {
+        m_stack_max_size = std::max<std::size_t>(max_size, 2);
+        m_stack_initial_size = std::clamp<std::size_t>(initial_size, 1, m_stack_max_size);
+    }
+
+    void State::setWorkersCount(const std::size_t count) noexcept
+    {
+        m_workers_count = count;
+    }
+
     void State::configure(const BytecodeReader& bcr)
     {
         using namespace internal;
@@ -171,7 +187,41 @@ namespace Ark
 
         m_symbols = syms.symbols;
         m_constants = vals.values;
-        m_pages = pages;
+        for (Value& constant : m_constants)
+        {
+            if (constant.valueType() == ValueType::String)
+                intern(constant);
+        }
+
+        m_pages.clear();
+        m_pages.reserve(pages.size());
+        for (const auto& page : pages)
+        {
+            DecodedPage& decoded = m_pages.emplace_back();
+            decoded.reserve(page.size() / 4);
+
+            // instructions are on 4 bytes
+            for (std::size_t i = 0; i + 3 < page.size(); i += 4)
+            {
+                const uint8_t padding = page[i + 1];
+                const auto arg = static_cast<uint16_t>((page[i + 2] << 8) + page[i + 3]);
+                decoded.push_back(
+                    DecodedInstruction {
+                        .inst = page[i],
+                        .arg = arg,
+                        .primary = static_cast<uint16_t>(arg & 0x0fff),
+                        .secondary = static_cast<uint16_t>((padding << 4) | (arg & 0xf000) >> 12) });
+            }
+        }
+    }
+
+    void State::intern(Value& constant)
+    {
+        auto [it, inserted] = m_interned_strings.try_emplace(constant.string(), constant);
+        if (inserted)
+            it->second.m_payload.string->interned = true;
+        else
+            constant = it->second;
     }
 
     void State::reset() noexcept
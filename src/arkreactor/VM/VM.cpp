@@ -1,5 +1,6 @@
 #include <Ark/VM/VM.hpp>
 
+#include <cstddef>
 #include <utility>
 #include <numeric>
 #include <limits>
@@ -22,6 +23,74 @@ namespace Ark
 {
     using namespace internal;
 
+    namespace
+    {
+        // context run by the current thread, the contexts created by async and spawn copy it
+        thread_local ExecutionContext* running_context = nullptr;
+
+        class RunningContextScope
+        {
+        public:
+            explicit RunningContextScope(ExecutionContext* context) noexcept :
+                m_previous(std::exchange(running_context, context))
+            {}
+
+            ~RunningContextScope()
+            {
+                running_context = m_previous;
+            }
+
+            RunningContextScope(const RunningContextScope&) = delete;
+            RunningContextScope& operator=(const RunningContextScope&) = delete;
+
+        private:
+            ExecutionContext* m_previous;
+        };
+
+        using ProcessChunk = std::function<void(ExecutionContext&, std::size_t, std::size_t)>;
+
+        // range of indices processed by VM::parallelFor, on its own context
+        class ChunkTask final : public Task
+        {
+        public:
+            ChunkTask(ExecutionContext* context, const std::size_t begin, const std::size_t end, const ProcessChunk& process, std::shared_ptr<std::atomic<std::size_t>> remaining) :
+                m_context(context), m_begin(begin), m_end(end), m_process(process), m_remaining(std::move(remaining))
+            {}
+
+            bool run() override
+            {
+                {
+                    const RunningScope running(this);
+                    try
+                    {
+                        m_process(*m_context, m_begin, m_end);
+                    }
+                    catch (...)
+                    {
+                        m_exception = std::current_exception();
+                    }
+                }
+
+                // the task can be destroyed as soon as the counter reaches 0, but not the counter
+                const auto remaining = m_remaining;
+                if (remaining->fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    remaining->notify_all();
+                return true;
+            }
+
+            [[nodiscard]] ExecutionContext* context() const noexcept { return m_context; }
+            [[nodiscard]] const std::exception_ptr& exception() const noexcept { return m_exception; }
+
+        private:
+            ExecutionContext* m_context;
+            std::size_t m_begin;
+            std::size_t m_end;
+            const ProcessChunk& m_process;
+            std::shared_ptr<std::atomic<std::size_t>> m_remaining;
+            std::exception_ptr m_exception;
+        };
+    }
+
     namespace helper
     {
         inline Value tail(Value* a)
@@ -31,19 +100,15 @@ namespace Ark
                 if (a->constList().size() < 2)
                     return Value(ValueType::List);
 
-                std::vector<Value> tmp(a->constList().size() - 1);
-                for (std::size_t i = 1, end = a->constList().size(); i < end; ++i)
-                    tmp[i - 1] = a->constList()[i];
-                return Value(std::move(tmp));
+                // a value holds a whole list, the remaining elements are copied: recursing on the tail of a list is quadratic
+                return Value(std::vector<Value>(a->constList().begin() + 1, a->constList().end()));
             }
             if (a->valueType() == ValueType::String)
             {
                 if (a->string().size() < 2)
                     return Value(ValueType::String);
 
-                Value b { *a };
-                b.stringRef().erase(b.stringRef().begin());
-                return b;
+                return Value(a->string().substr(1));
             }
 
             types::generateError(
@@ -65,7 +130,7 @@ namespace Ark
             {
                 if (a->string().empty())
                     return Value(ValueType::String);
-                return Value(std::string(1, a->stringRef()[0]));
+                return Value(std::string(1, a->string()[0]));
             }
 
             types::generateError(
@@ -79,7 +144,7 @@ namespace Ark
     VM::VM(State& state) noexcept :
         m_state(state), m_exit_code(0), m_running(false)
     {
-        m_execution_contexts.emplace_back(std::make_unique<ExecutionContext>())->locals.reserve(4);
+        m_execution_contexts.emplace_back(std::make_unique<ExecutionContext>(m_state.m_stack_initial_size))->locals.reserve(4);
     }
 
     void VM::init() noexcept
@@ -96,6 +161,8 @@ namespace Ark
         context.fc = 1;
 
         m_shared_lib_objects.clear();
+        // the code may have changed
+        prepareCode();
         context.stacked_closure_scopes.clear();
         context.stacked_closure_scopes.emplace_back(nullptr);
 
@@ -103,7 +170,9 @@ namespace Ark
         m_exit_code = 0;
 
         context.locals.clear();
-        context.locals.emplace_back();
+        // the global scope is indexed by symbol id, to load globals in constant time
+        context.locals.emplace_back(m_state.m_symbols.size());
+        context.children_snapshot.reset();
 
         // loading bound stuff
         // put them in the global frame if we can, aka the first one
@@ -115,6 +184,23 @@ namespace Ark
         }
     }
 
+    void VM::prepareCode() noexcept
+    {
+        // the workers could still be running futures and coroutines of the previous code,
+        // the scheduler waits for them when being destroyed and will be created again by the next one
+        m_scheduler.reset();
+
+        m_field_caches.clear();
+        m_field_caches.reserve(m_state.m_pages.size());
+        for (const auto& decoded_page : m_state.m_pages)
+            m_field_caches.emplace_back(decoded_page.size());
+
+        m_threaded_pages.clear();
+        m_pages_threaded.store(false, std::memory_order_release);
+        if (m_jit)
+            m_jit->reset();
+    }
+
     Value& VM::operator[](const std::string& name) noexcept
     {
         // find id of object
@@ -133,7 +219,11 @@ namespace Ark
             const auto id = static_cast<uint16_t>(dist);
             Value* var = findNearestVariable(id, context);
             if (var != nullptr)
+            {
+                // the value can be modified through the reference
+                context.locals.front().markModified(id);
                 return *var;
+            }
         }
 
         m_no_value = Builtins::nil;
@@ -144,7 +234,7 @@ namespace Ark
     {
         namespace fs = std::filesystem;
 
-        const std::string file = m_state.m_constants[id].stringRef();
+        const std::string file = m_state.m_constants[id].string();
 
         std::string path = file;
         // bytecode loaded from file
@@ -227,18 +317,47 @@ namespace Ark
     ExecutionContext* VM::createAndGetContext()
     {
         const std::lock_guard lock(m_mutex);
+        return createContext();
+    }
 
-        m_execution_contexts.push_back(std::make_unique<ExecutionContext>());
+    ExecutionContext* VM::createContext()
+    {
+        // a future or a coroutine creating another one shares its own environment with it
+        ExecutionContext& parent = running_context != nullptr ? *running_context : *m_execution_contexts.front();
+        Scope& globals = parent.locals.front();
+        // the snapshot is shared until a global changes, and then only the modified chunks are copied.
+        // the global scope of a created context is filled lazily, on top of the snapshot it was given
+        if (parent.children_snapshot == nullptr)
+            parent.children_snapshot = parent.globals_snapshot;
+        if (parent.children_snapshot == nullptr || globals.modifiedSinceSnapshot())
+            parent.children_snapshot = std::make_shared<const ScopeSnapshot>(globals, parent.children_snapshot.get());
+
+        m_execution_contexts.push_back(std::make_unique<ExecutionContext>(m_state.m_stack_initial_size));
         ExecutionContext* ctx = m_execution_contexts.back().get();
         ctx->stacked_closure_scopes.emplace_back(nullptr);
 
-        ctx->locals.reserve(m_execution_contexts.front()->locals.size());
-        for (const auto& local : m_execution_contexts.front()->locals)
-            ctx->locals.push_back(local);
+        // the globals are copied from the snapshot when they are first accessed,
+        // only the frames of the functions being called are copied
+        ctx->globals_snapshot = parent.children_snapshot;
+        ctx->locals.reserve(parent.locals.size());
+        ctx->locals.emplace_back(m_state.m_symbols.size()).resetModified();
+        for (auto it = parent.locals.begin() + 1, end = parent.locals.end(); it != end; ++it)
+            ctx->locals.push_back(*it);
+        // with the environments of the closures being called, which are shared
+        ctx->stacked_closure_scopes.insert(ctx->stacked_closure_scopes.end(), parent.stacked_closure_scopes.begin() + 1, parent.stacked_closure_scopes.end());
 
         return ctx;
     }
 
+    void VM::growStack(ExecutionContext& context)
+    {
+        const std::size_t size = context.stack.size();
+        if (size >= m_state.m_stack_max_size)
+            throwVMError(ErrorKind::VM, fmt::format("Stack overflow, can not push more than {} values on the stack", m_state.m_stack_max_size));
+
+        context.stack.resize(std::min(size * 2, m_state.m_stack_max_size));
+    }
+
     void VM::deleteContext(ExecutionContext* ec)
     {
         const std::lock_guard lock(m_mutex);
@@ -255,14 +374,128 @@ namespace Ark
 
     Future* VM::createFuture(std::vector<Value>& args)
     {
-        ExecutionContext* ctx = createAndGetContext();
+        Future* future = nullptr;
+        {
+            const std::lock_guard lock(m_mutex);
 
-        // doing this after having created the context
-        // because the context uses the mutex and we don't want a deadlock
-        const std::lock_guard lock(m_mutex);
-        m_futures.push_back(std::make_unique<Future>(ctx, this, args));
+            ExecutionContext* ctx = createContext();
+            future = m_futures.emplace_back(std::make_unique<Future>(ctx, this, args)).get();
+            getScheduler();
+        }
+
+        // submitted outside the lock as a worker may take the future right away and create its own
+        m_scheduler->submit(future);
+        return future;
+    }
+
+    Coroutine* VM::createCoroutine(std::vector<Value>& args)
+    {
+        Coroutine* coroutine = nullptr;
+        {
+            const std::lock_guard lock(m_mutex);
+
+            ExecutionContext* ctx = createContext();
+            coroutine = m_coroutines.emplace_back(std::make_unique<Coroutine>(ctx, this, args)).get();
+            getScheduler();
+        }
+
+        m_scheduler->submit(coroutine);
+        return coroutine;
+    }
+
+    void VM::parallelFor(const std::size_t count, const ProcessChunk& process)
+    {
+        if (count == 0)
+            return;
+
+        auto remaining = std::make_shared<std::atomic<std::size_t>>(0);
+        std::vector<std::unique_ptr<ChunkTask>> chunks;
+        {
+            const std::lock_guard lock(m_mutex);
+
+            // a few chunks per worker, so that the threads done early can steal the remaining ones
+            const std::size_t chunks_count = std::min(count, getScheduler().workersCount() * 4);
+            chunks.reserve(chunks_count);
+            for (std::size_t i = 0; i < chunks_count; ++i)
+                chunks.push_back(std::make_unique<ChunkTask>(createContext(), i * count / chunks_count, (i + 1) * count / chunks_count, process, remaining));
+            remaining->store(chunks_count, std::memory_order_release);
+        }
+
+        for (const auto& chunk : chunks)
+            m_scheduler->submit(chunk.get());
+
+        for (std::size_t left = remaining->load(std::memory_order_acquire); left != 0; left = remaining->load(std::memory_order_acquire))
+        {
+            if (!m_scheduler->runPendingTask())
+                remaining->wait(left, std::memory_order_acquire);
+        }
+
+        for (const auto& chunk : chunks)
+            deleteContext(chunk->context());
+        for (const auto& chunk : chunks)
+        {
+            if (chunk->exception())
+                std::rethrow_exception(chunk->exception());
+        }
+    }
+
+    Scheduler& VM::getScheduler()
+    {
+        if (!m_scheduler)
+        {
+            const std::size_t count = m_state.m_workers_count != 0 ? m_state.m_workers_count : std::thread::hardware_concurrency();
+            m_scheduler = std::make_unique<Scheduler>(count);
+        }
+        return *m_scheduler;
+    }
+
+    void VM::runNativeCode(ExecutionContext& context, const std::size_t jump)
+    {
+        // the native code reads and writes the values directly
+        static_assert(offsetof(Value, m_type) == 0 && offsetof(Value, m_payload) == 8 && sizeof(Value) == 16);
+
+        JitPage* native = m_jit->hotPage(m_state.m_pages, context.pp, m_state.m_constants);
+        if (native == nullptr || !native->isNativeLoop(jump))
+            return;
+
+        // the native code doesn't create nor delete variables, their addresses don't change while it runs
+        m_jit_variables.clear();
+        for (const JitVariable& variable : native->variables())
+        {
+            Value* var = variable.global ? context.locals.front().fromIndex(variable.id) : findNearestVariable(variable.id, context);
+            if (var != nullptr && var->valueType() == ValueType::Reference)
+                var = var->reference();
+            m_jit_variables.push_back(var);
+        }
 
-        return m_futures.back().get();
+        Scope& scope = context.locals.back();
+        JitFrame frame { .top = nullptr, .last_symbol = context.last_symbol, .locals_count = scope.m_data.size() };
+        Value* stack = context.stack.data();
+        context.ip = native->entry(context.ip)(
+            stack,
+            stack + context.sp,
+            m_jit_variables.data(),
+            scope.m_data.data(),
+            stack + context.stack.size(),
+            &frame);
+        context.sp = static_cast<std::size_t>(frame.top - stack);
+        context.last_symbol = frame.last_symbol;
+
+        // the variables may be globals
+        for (const JitVariable& variable : native->variables())
+        {
+            if (variable.written)
+                context.locals.front().markModified(variable.id);
+        }
+    }
+
+    bool VM::enableJit()
+    {
+        if (!Jit::isAvailable())
+            return false;
+        if (!m_jit)
+            m_jit = std::make_unique<Jit>(*m_execution_contexts.front());
+        return true;
     }
 
     void VM::deleteFuture(Future* f)
@@ -323,38 +556,69 @@ namespace Ark
 #    define TARGET(op) TARGET_##op:
 #    define DISPATCH_GOTO()            \
         _Pragma("GCC diagnostic push") \
-            _Pragma("GCC diagnostic ignored \"-Wpedantic\"") goto* opcode_targets[inst];
+            _Pragma("GCC diagnostic ignored \"-Wpedantic\"") goto* handler;
         _Pragma("GCC diagnostic pop")
 #    define GOTO_HALT() goto dispatch_end
+// the handlers can be replaced while other threads run the same page, see QUICKEN
+#    define NEXTOPARG()                                                                 \
+        do                                                                              \
+        {                                                                               \
+            ThreadedInstruction& current = page[context.ip];                            \
+            handler = std::atomic_ref(current.handler).load(std::memory_order_relaxed); \
+            arg = current.arg;                                                          \
+            ++context.ip;                                                               \
+        } while (false)
+#    define LOAD_PAGE() page = m_threaded_pages[context.pp].data()
+// replace the handler of the current instruction by a version specialized for the types of its operands
+#    define QUICKEN(op)                                                                                            \
+        do                                                                                                         \
+        {                                                                                                          \
+            _Pragma("GCC diagnostic push")                                                                         \
+                _Pragma("GCC diagnostic ignored \"-Wpedantic\"")                                                   \
+                    std::atomic_ref(page[context.ip - 1].handler).store(&&TARGET_##op, std::memory_order_relaxed); \
+            _Pragma("GCC diagnostic pop")                                                                          \
+        } while (false)
+// go back to the generic version of the current instruction, which runs with the operands left on the stack
+#    define DEOPTIMIZE(op)    \
+        do                    \
+        {                     \
+            QUICKEN(op);      \
+            goto TARGET_##op; \
+        } while (false)
 #else
 #    define TARGET(op) case op:
 #    define DISPATCH_GOTO() goto dispatch_opcode
 #    define GOTO_HALT() break
+#    define NEXTOPARG()                                           \
+        do                                                        \
+        {                                                         \
+            const DecodedInstruction& current = page[context.ip]; \
+            inst = current.inst;                                  \
+            arg = current.arg;                                    \
+            ++context.ip;                                         \
+        } while (false)
+#    define LOAD_PAGE() page = m_state.m_pages[context.pp].data()
+// the decoded pages belong to the state, the instructions are only specialized in the threaded pages of the VM
+#    define QUICKEN(op) \
+        do              \
+        {               \
+        } while (false)
 #endif
 
-#define NEXTOPARG()                                                                      \
-    do                                                                                   \
-    {                                                                                    \
-        inst = m_state.m_pages[context.pp][context.ip];                                  \
-        padding = m_state.m_pages[context.pp][context.ip + 1];                           \
-        arg = static_cast<uint16_t>((m_state.m_pages[context.pp][context.ip + 2] << 8) + \
-                                    m_state.m_pages[context.pp][context.ip + 3]);        \
-        context.ip += 4;                                                                 \
-    } while (false)
 #define DISPATCH() \
     NEXTOPARG();   \
     DISPATCH_GOTO();
-#define UNPACK_ARGS()                                                                 \
-    do                                                                                \
-    {                                                                                 \
-        secondary_arg = static_cast<uint16_t>((padding << 4) | (arg & 0xf000) >> 12); \
-        primary_arg = arg & 0x0fff;                                                   \
+#define UNPACK_ARGS()                                   \
+    do                                                  \
+    {                                                   \
+        primary_arg = page[context.ip - 1].primary;     \
+        secondary_arg = page[context.ip - 1].secondary; \
     } while (false)
 
 #if ARK_USE_COMPUTED_GOTOS
 #    pragma GCC diagnostic push
 #    pragma GCC diagnostic ignored "-Wpedantic"
-            const std::array opcode_targets = {
+            static const std::array opcode_targets = {
                 &&TARGET_NOP,
                 &&TARGET_LOAD_SYMBOL,
                 &&TARGET_LOAD_CONST,
@@ -415,15 +679,63 @@ namespace Ark
                 &&TARGET_STORE_HEAD,
                 &&TARGET_SET_VAL_TAIL,
                 &&TARGET_SET_VAL_HEAD,
-                &&TARGET_CALL_BUILTIN
+                &&TARGET_CALL_BUILTIN,
+                &&TARGET_LOAD_LOCAL,
+                &&TARGET_STORE_LOCAL,
+                &&TARGET_LOAD_UPVALUE,
+                &&TARGET_GLOBAL_LOAD,
+                &&TARGET_GLOBAL_STORE,
+                &&TARGET_TAIL_CALL,
+                &&TARGET_GET_FIELD_CALL,
+                &&TARGET_LOAD_SYMBOL_LOAD_CONST_ADD,
+                &&TARGET_LOAD_SYMBOL_GET_FIELD,
+                &&TARGET_JUMP_IF_LT,
+                &&TARGET_JUMP_IF_LE,
+                &&TARGET_JUMP_IF_GT,
+                &&TARGET_JUMP_IF_GE,
+                &&TARGET_JUMP_IF_EQ,
+                &&TARGET_JUMP_IF_NEQ
             };
 #    pragma GCC diagnostic pop
 #endif
 
+        const RunningContextScope running(&context);
+
         try
         {
+#if ARK_USE_COMPUTED_GOTOS
+            // replace the opcodes by the address of their implementation, once per program.
+            // the addresses are only known here, the first context to get there builds the pages for all of them
+            if (!m_pages_threaded.load(std::memory_order_acquire)) [[unlikely]]
+            {
+                const std::lock_guard lock(m_mutex);
+                if (!m_pages_threaded.load(std::memory_order_relaxed))
+                {
+                    m_threaded_pages.reserve(m_state.m_pages.size());
+                    for (const auto& decoded_page : m_state.m_pages)
+                    {
+                        ThreadedPage& threaded = m_threaded_pages.emplace_back();
+                        threaded.reserve(decoded_page.size());
+                        for (const auto& decoded : decoded_page)
+                            threaded.push_back(
+                                ThreadedInstruction {
+                                    .handler = opcode_targets[decoded.inst],
+                                    .arg = decoded.arg,
+                                    .primary = decoded.primary,
+                                    .secondary = decoded.secondary });
+                    }
+                    m_pages_threaded.store(true, std::memory_order_release);
+                }
+            }
+
+            ThreadedInstruction* page = nullptr;
+            const void* handler = nullptr;
+#else
+            const DecodedInstruction* page = nullptr;
             uint8_t inst = 0;
-            uint8_t padding = 0;
+#endif
+            // the page pointer only changes when calling a function or returning from one
+            LOAD_PAGE();
             uint16_t arg = 0;
             uint16_t primary_arg = 0;
             uint16_t secondary_arg = 0;
@@ -458,7 +770,7 @@ namespace Ark
                     TARGET(POP_JUMP_IF_TRUE)
                     {
                         if (Value boolean = *popAndResolveAsPtr(context); !!boolean)
-                            context.ip = arg * 4;  // instructions are 4 bytes
+                            context.ip = arg;
                         DISPATCH();
                     }
 
@@ -477,13 +789,21 @@ namespace Ark
                     TARGET(POP_JUMP_IF_FALSE)
                     {
                         if (Value boolean = *popAndResolveAsPtr(context); !boolean)
-                            context.ip = arg * 4;  // instructions are 4 bytes
+                            context.ip = arg;
                         DISPATCH();
                     }
 
                     TARGET(JUMP)
                     {
-                        context.ip = arg * 4;  // instructions are 4 bytes
+#ifdef ARK_ENABLE_JIT
+                        const std::size_t jump = context.ip - 1;
+                        context.ip = arg;
+                        // only the main context runs native code, the JIT counters and pages aren't shared between threads
+                        if (m_jit && arg <= jump && m_jit->runsOn(context))
+                            runNativeCode(context, jump);
+#else
+                        context.ip = arg;
+#endif
                         DISPATCH();
                     }
 
@@ -522,6 +842,7 @@ namespace Ark
                                 GOTO_HALT();
                         }
 
+                        LOAD_PAGE();
                         DISPATCH();
                     }
 
@@ -534,15 +855,62 @@ namespace Ark
                     TARGET(CALL)
                     {
                         // stack pointer + 2 because we push IP and PP
-                        if (context.sp + 2u >= VMStackSize) [[unlikely]]
+                        if (context.sp + 2u >= m_state.m_stack_max_size) [[unlikely]]
                             throwVMError(
                                 ErrorKind::VM,
                                 fmt::format(
                                     "Maximum recursion depth exceeded. You could consider rewriting your function `{}' to make use of tail-call optimization.",
                                     m_state.m_symbols[context.last_symbol]));
                         call(context, arg);
-                        if (!m_running)
+                        if (!m_running || context.yielded) [[unlikely]]
+                            GOTO_HALT();
+                        LOAD_PAGE();
+                        DISPATCH();
+                    }
+
+                    TARGET(TAIL_CALL)
+                    {
+                        tailCall(context, arg);
+                        if (!m_running || context.yielded) [[unlikely]]
+                            GOTO_HALT();
+                        // a builtin call returns directly to the caller
+                        if (context.fc <= untilFrameCount)
+                            GOTO_HALT();
+                        LOAD_PAGE();
+                        DISPATCH();
+                    }
+
+                    TARGET(GET_FIELD_CALL)
+                    {
+                        UNPACK_ARGS();
+                        // stack pointer + 2 because we push IP and PP
+                        if (context.sp + 2u >= m_state.m_stack_max_size) [[unlikely]]
+                            throwVMError(
+                                ErrorKind::VM,
+                                fmt::format(
+                                    "Maximum recursion depth exceeded. You could consider rewriting your function `{}' to make use of tail-call optimization.",
+                                    m_state.m_symbols[primary_arg]));
+
+                        Value* var = popAndResolveAsPtr(context);
+                        if (var->valueType() != ValueType::Closure) [[unlikely]]
+                            throwNotAClosureError(*var, primary_arg, context);
+
+                        Closure& closure = var->refClosure();
+                        Value* field = getField(closure, primary_arg, m_field_caches[context.pp][context.ip - 1]);
+                        if (field == nullptr) [[unlikely]]
+                            throwVMError(ErrorKind::Scope, fmt::format("`{}' isn't in the closure environment: {}", m_state.m_symbols[primary_arg], closure.toString(*this)));
+
+                        // a method is called with the scope of its closure, without creating a closure for it
+                        if (field->valueType() == ValueType::PageAddr)
+                            callClosure(context, closure.scopePtr(), field->pageAddr(), secondary_arg);
+                        else
+                        {
+                            push(field, context);
+                            call(context, secondary_arg);
+                        }
+                        if (!m_running || context.yielded) [[unlikely]]
                             GOTO_HALT();
+                        LOAD_PAGE();
                         DISPATCH();
                     }
 
@@ -552,6 +920,9 @@ namespace Ark
                             context.saved_scope = Scope();
 
                         Value* ptr = (context.locals.back())[arg];
+                        // capturing a variable captured by the current closure
+                        if (!ptr && context.stacked_closure_scopes.back() != nullptr)
+                            ptr = (*context.stacked_closure_scopes.back())[arg];
                         if (!ptr)
                             throwVMError(ErrorKind::Scope, fmt::format("Couldn't capture `{}' as it is currently unbound", m_state.m_symbols[arg]));
                         else
@@ -576,6 +947,7 @@ namespace Ark
                             if (var->valueType() == ValueType::User)
                                 var->usertypeRef().del();
                             *var = Value();
+                            context.locals.front().markModified(arg);
                             DISPATCH();
                         }
 
@@ -592,28 +964,14 @@ namespace Ark
                     TARGET(GET_FIELD)
                     {
                         Value* var = popAndResolveAsPtr(context);
-                        if (var->valueType() != ValueType::Closure)
-                        {
-                            if (context.last_symbol < m_state.m_symbols.size()) [[likely]]
-                                throwVMError(
-                                    ErrorKind::Type,
-                                    fmt::format(
-                                        "`{}' is a {}, not a Closure, can not get the field `{}' from it",
-                                        m_state.m_symbols[context.last_symbol],
-                                        types_to_str[static_cast<std::size_t>(var->valueType())],
-                                        m_state.m_symbols[arg]));
-                            else
-                                throwVMError(ErrorKind::Type,
-                                             fmt::format(
-                                                 "{} is not a Closure, can not get the field `{}' from it",
-                                                 types_to_str[static_cast<std::size_t>(var->valueType())],
-                                                 m_state.m_symbols[arg]));
-                        }
+                        if (var->valueType() != ValueType::Closure) [[unlikely]]
+                            throwNotAClosureError(*var, arg, context);
 
-                        if (Value* field = var->refClosure().refScope()[arg]; field != nullptr)
+                        if (Value* field = getField(var->refClosure(), arg, m_field_caches[context.pp][context.ip - 1]); field != nullptr)
                         {
                             // check for CALL instruction (the instruction because context.ip is already on the next instruction word)
-                            if (m_state.m_pages[context.pp][context.ip] == CALL)
+                            const uint8_t next_inst = m_state.m_pages[context.pp][context.ip].inst;
+                            if ((next_inst == CALL || next_inst == TAIL_CALL) && field->valueType() == ValueType::PageAddr)
                                 push(Value(Closure(var->refClosure().scopePtr(), field->pageAddr())), context);
                             else
                                 push(field, context);
@@ -653,10 +1011,9 @@ namespace Ark
                                     { { types::Contract { { types::Typedef("list", ValueType::List) } } } },
                                     { *list });
 
-                            const auto size = static_cast<uint16_t>(list->constList().size());
-
-                            Value obj { *list };
-                            obj.list().reserve(size + arg);
+                            Value obj(ValueType::List);
+                            obj.list().reserve(list->constList().size() + arg);
+                            std::ranges::copy(list->constList(), std::back_inserter(obj.list()));
 
                             for (uint16_t i = 0; i < arg; ++i)
                                 obj.push_back(*popAndResolveAsPtr(context));
@@ -687,7 +1044,7 @@ namespace Ark
                                         { { types::Contract { { types::Typedef("dst", ValueType::List), types::Typedef("src", ValueType::List) } } } },
                                         { *list, *next });
 
-                                std::ranges::copy(next->list(), std::back_inserter(obj.list()));
+                                std::ranges::copy(next->constList(), std::back_inserter(obj.list()));
                             }
                             push(std::move(obj), context);
                         }
@@ -706,6 +1063,8 @@ namespace Ark
 
                         for (uint16_t i = 0; i < arg; ++i)
                             list->push_back(*popAndResolveAsPtr(context));
+                        // the list may be a global
+                        context.locals.front().markModified(list);
                         DISPATCH();
                     }
 
@@ -729,8 +1088,11 @@ namespace Ark
                                     { { types::Contract { { types::Typedef("dst", ValueType::List), types::Typedef("src", ValueType::List) } } } },
                                     { *list, *next });
 
-                            std::ranges::copy(next->list(), std::back_inserter(list->list()));
+                            // keep the source alive and shared, in case it is the destination itself
+                            const Value source = *next;
+                            std::ranges::copy(source.constList(), std::back_inserter(list->list()));
                         }
+                        context.locals.front().markModified(list);
                         DISPATCH();
                     }
 
@@ -779,6 +1141,7 @@ namespace Ark
                                     fmt::format("pop! index ({}) out of range (list size: {})", idx, list->list().size()));
 
                             list->list().erase(list->list().begin() + idx);
+                            context.locals.front().markModified(list);
                         }
                         DISPATCH();
                     }
@@ -791,8 +1154,7 @@ namespace Ark
 
                     TARGET(DUP)
                     {
-                        context.stack[context.sp] = context.stack[context.sp - 1];
-                        ++context.sp;
+                        push(context.stack[context.sp - 1], context);
                         DISPATCH();
                     }
 
@@ -805,7 +1167,10 @@ namespace Ark
                         Value *b = popAndResolveAsPtr(context), *a = popAndResolveAsPtr(context);
 
                         if (a->valueType() == ValueType::Number && b->valueType() == ValueType::Number)
+                        {
+                            QUICKEN(ADD_NUM_NUM);
                             push(Value(a->number() + b->number()), context);
+                        }
                         else if (a->valueType() == ValueType::String && b->valueType() == ValueType::String)
                             push(Value(a->string() + b->string()), context);
                         else
@@ -826,6 +1191,7 @@ namespace Ark
                                 "-",
                                 { { types::Contract { { types::Typedef("a", ValueType::Number), types::Typedef("b", ValueType::Number) } } } },
                                 { *a, *b });
+                        QUICKEN(SUB_NUM_NUM);
                         push(Value(a->number() - b->number()), context);
                         DISPATCH();
                     }
@@ -839,6 +1205,7 @@ namespace Ark
                                 "*",
                                 { { types::Contract { { types::Typedef("a", ValueType::Number), types::Typedef("b", ValueType::Number) } } } },
                                 { *a, *b });
+                        QUICKEN(MUL_NUM_NUM);
                         push(Value(a->number() * b->number()), context);
                         DISPATCH();
                     }
@@ -863,6 +1230,8 @@ namespace Ark
                     TARGET(GT)
                     {
                         Value *b = popAndResolveAsPtr(context), *a = popAndResolveAsPtr(context);
+                        if (a->valueType() == ValueType::Number && b->valueType() == ValueType::Number)
+                            QUICKEN(GT_NUM_NUM);
                         push((*a != *b && !(*a < *b)) ? Builtins::trueSym : Builtins::falseSym, context);
                         DISPATCH();
                     }
@@ -870,6 +1239,8 @@ namespace Ark
                     TARGET(LT)
                     {
                         Value *b = popAndResolveAsPtr(context), *a = popAndResolveAsPtr(context);
+                        if (a->valueType() == ValueType::Number && b->valueType() == ValueType::Number)
+                            QUICKEN(LT_NUM_NUM);
                         push((*a < *b) ? Builtins::trueSym : Builtins::falseSym, context);
                         DISPATCH();
                     }
@@ -877,6 +1248,8 @@ namespace Ark
                     TARGET(LE)
                     {
                         Value *b = popAndResolveAsPtr(context), *a = popAndResolveAsPtr(context);
+                        if (a->valueType() == ValueType::Number && b->valueType() == ValueType::Number)
+                            QUICKEN(LE_NUM_NUM);
                         push((((*a < *b) || (*a == *b)) ? Builtins::trueSym : Builtins::falseSym), context);
                         DISPATCH();
                     }
@@ -884,6 +1257,8 @@ namespace Ark
                     TARGET(GE)
                     {
                         Value *b = popAndResolveAsPtr(context), *a = popAndResolveAsPtr(context);
+                        if (a->valueType() == ValueType::Number && b->valueType() == ValueType::Number)
+                            QUICKEN(GE_NUM_NUM);
                         push(!(*a < *b) ? Builtins::trueSym : Builtins::falseSym, context);
                         DISPATCH();
                     }
@@ -968,7 +1343,7 @@ namespace Ark
                                 { *a, *b });
 
                         if (*a == Builtins::falseSym)
-                            throw AssertionFailed(b->stringRef());
+                            throw AssertionFailed(b->string());
                         DISPATCH();
                     }
 
@@ -1014,12 +1389,12 @@ namespace Ark
 
                             if (a.valueType() == ValueType::List)
                             {
-                                if (std::cmp_less(std::abs(idx), a.list().size()))
-                                    push(a.list()[static_cast<std::size_t>(idx < 0 ? static_cast<long>(a.list().size()) + idx : idx)], context);
+                                if (std::cmp_less(std::abs(idx), a.constList().size()))
+                                    push(a.constList()[static_cast<std::size_t>(idx < 0 ? static_cast<long>(a.constList().size()) + idx : idx)], context);
                                 else
                                     throwVMError(
                                         ErrorKind::Index,
-                                        fmt::format("{} out of range {} (length {})", idx, a.toString(*this), a.list().size()));
+                                        fmt::format("{} out of range {} (length {})", idx, a.toString(*this), a.constList().size()));
                             }
                             else if (a.valueType() == ValueType::String)
                             {
@@ -1075,7 +1450,7 @@ namespace Ark
                                     { { types::Contract { { types::Typedef("closure", ValueType::Closure), types::Typedef("field", ValueType::String) } } } },
                                     { *closure, *field });
 
-                            auto it = std::find(m_state.m_symbols.begin(), m_state.m_symbols.end(), field->stringRef());
+                            auto it = std::find(m_state.m_symbols.begin(), m_state.m_symbols.end(), field->string());
                             if (it == m_state.m_symbols.end())
                             {
                                 push(Builtins::falseSym, context);
@@ -1225,11 +1600,250 @@ namespace Ark
                         UNPACK_ARGS();
                         // no stack size check because we do not push IP/PP since we are just calling a builtin
                         callBuiltin(context, Builtins::builtins[primary_arg].second, secondary_arg);
-                        if (!m_running)
+                        if (!m_running || context.yielded) [[unlikely]]
                             GOTO_HALT();
                         DISPATCH();
                     }
+
+                    TARGET(LOAD_LOCAL)
+                    {
+                        push(loadLocal(arg, context), context);
+                        DISPATCH();
+                    }
+
+                    TARGET(STORE_LOCAL)
+                    {
+                        setLocal(arg, popAndResolveAsPtr(context), context);
+                        DISPATCH();
+                    }
+
+                    TARGET(LOAD_UPVALUE)
+                    {
+                        push(loadUpvalue(arg, context), context);
+                        DISPATCH();
+                    }
+
+                    TARGET(GLOBAL_LOAD)
+                    {
+                        push(loadGlobal(arg, context), context);
+                        DISPATCH();
+                    }
+
+                    TARGET(GLOBAL_STORE)
+                    {
+                        setGlobal(arg, popAndResolveAsPtr(context), context);
+                        DISPATCH();
+                    }
+
+                    TARGET(LOAD_SYMBOL_LOAD_CONST_ADD)
+                    {
+                        UNPACK_ARGS();
+                        {
+                            Value* a = loadSymbol(primary_arg, context);
+                            const Value* b = loadConstAsPtr(secondary_arg);
+
+                            // use internal reference, shouldn't break anything so far, unless it's already a ref
+                            if (a->valueType() == ValueType::Reference)
+                                a = a->reference();
+
+                            if (a->valueType() == ValueType::Number && b->valueType() == ValueType::Number)
+                                push(Value(a->number() + b->number()), context);
+                            else if (a->valueType() == ValueType::String && b->valueType() == ValueType::String)
+                                push(Value(a->string() + b->string()), context);
+                            else
+                                types::generateError(
+                                    "+",
+                                    { { types::Contract { { types::Typedef("a", ValueType::Number), types::Typedef("b", ValueType::Number) } },
+                                        types::Contract { { types::Typedef("a", ValueType::String), types::Typedef("b", ValueType::String) } } } },
+                                    { *a, *b });
+                        }
+                        DISPATCH();
+                    }
+
+                    TARGET(LOAD_SYMBOL_GET_FIELD)
+                    {
+                        UNPACK_ARGS();
+                        {
+                            Value* var = loadSymbol(primary_arg, context);
+                            if (var->valueType() == ValueType::Reference)
+                                var = var->reference();
+                            if (var->valueType() != ValueType::Closure) [[unlikely]]
+                                throwNotAClosureError(*var, secondary_arg, context);
+
+                            if (Value* field = getField(var->refClosure(), secondary_arg, m_field_caches[context.pp][context.ip - 1]); field != nullptr)
+                            {
+                                // same as GET_FIELD, a method called right after is bound to the closure scope
+                                const uint8_t next_inst = m_state.m_pages[context.pp][context.ip].inst;
+                                if ((next_inst == CALL || next_inst == TAIL_CALL) && field->valueType() == ValueType::PageAddr)
+                                    push(Value(Closure(var->refClosure().scopePtr(), field->pageAddr())), context);
+                                else
+                                    push(field, context);
+                            }
+                            else
+                                throwVMError(ErrorKind::Scope, fmt::format("`{}' isn't in the closure environment: {}", m_state.m_symbols[secondary_arg], var->refClosure().toString(*this)));
+                        }
+                        DISPATCH();
+                    }
+
+                    TARGET(JUMP_IF_LT)
+                    {
+                        // the comparison is done on the numbers directly, without creating a boolean
+                        if (double a, b; peekNumbers(context, a, b)) [[likely]]
+                        {
+                            context.sp -= 2;
+                            if (a < b)
+                                context.ip = arg;
+                        }
+                        else
+                        {
+                            Value *rhs = popAndResolveAsPtr(context), *lhs = popAndResolveAsPtr(context);
+                            if (*lhs < *rhs)
+                                context.ip = arg;
+                        }
+                        DISPATCH();
+                    }
+
+                    TARGET(JUMP_IF_LE)
+                    {
+                        if (double a, b; peekNumbers(context, a, b)) [[likely]]
+                        {
+                            context.sp -= 2;
+                            if (a < b || a == b)
+                                context.ip = arg;
+                        }
+                        else
+                        {
+                            Value *rhs = popAndResolveAsPtr(context), *lhs = popAndResolveAsPtr(context);
+                            if ((*lhs < *rhs) || (*lhs == *rhs))
+                                context.ip = arg;
+                        }
+                        DISPATCH();
+                    }
+
+                    TARGET(JUMP_IF_GT)
+                    {
+                        if (double a, b; peekNumbers(context, a, b)) [[likely]]
+                        {
+                            context.sp -= 2;
+                            if (a != b && !(a < b))
+                                context.ip = arg;
+                        }
+                        else
+                        {
+                            Value *rhs = popAndResolveAsPtr(context), *lhs = popAndResolveAsPtr(context);
+                            if (*lhs != *rhs && !(*lhs < *rhs))
+                                context.ip = arg;
+                        }
+                        DISPATCH();
+                    }
+
+                    TARGET(JUMP_IF_GE)
+                    {
+                        if (double a, b; peekNumbers(context, a, b)) [[likely]]
+                        {
+                            context.sp -= 2;
+                            if (!(a < b))
+                                context.ip = arg;
+                        }
+                        else
+                        {
+                            Value *rhs = popAndResolveAsPtr(context), *lhs = popAndResolveAsPtr(context);
+                            if (!(*lhs < *rhs))
+                                context.ip = arg;
+                        }
+                        DISPATCH();
+                    }
+
+                    TARGET(JUMP_IF_EQ)
+                    {
+                        if (Value *b = popAndResolveAsPtr(context), *a = popAndResolveAsPtr(context); *a == *b)
+                            context.ip = arg;
+                        DISPATCH();
+                    }
+
+                    TARGET(JUMP_IF_NEQ)
+                    {
+                        if (Value *b = popAndResolveAsPtr(context), *a = popAndResolveAsPtr(context); *a != *b)
+                            context.ip = arg;
+                        DISPATCH();
+                    }
+#pragma endregion
+
+#if ARK_USE_COMPUTED_GOTOS
+#pragma region "Quickened Instructions"
+                    // specialized versions of the operators, installed by the generic ones when they see numbers
+                    TARGET(ADD_NUM_NUM)
+                    {
+                        double a, b;
+                        if (!peekNumbers(context, a, b)) [[unlikely]]
+                            DEOPTIMIZE(ADD);
+                        --context.sp;
+                        // the slot of the first operand holds a number or a reference, nothing has to be released
+                        context.stack[context.sp - 1] = Value(a + b);
+                        DISPATCH();
+                    }
+
+                    TARGET(SUB_NUM_NUM)
+                    {
+                        double a, b;
+                        if (!peekNumbers(context, a, b)) [[unlikely]]
+                            DEOPTIMIZE(SUB);
+                        --context.sp;
+                        context.stack[context.sp - 1] = Value(a - b);
+                        DISPATCH();
+                    }
+
+                    TARGET(MUL_NUM_NUM)
+                    {
+                        double a, b;
+                        if (!peekNumbers(context, a, b)) [[unlikely]]
+                            DEOPTIMIZE(MUL);
+                        --context.sp;
+                        context.stack[context.sp - 1] = Value(a * b);
+                        DISPATCH();
+                    }
+
+                    TARGET(GT_NUM_NUM)
+                    {
+                        double a, b;
+                        if (!peekNumbers(context, a, b)) [[unlikely]]
+                            DEOPTIMIZE(GT);
+                        --context.sp;
+                        context.stack[context.sp - 1] = (a != b && !(a < b)) ? Builtins::trueSym : Builtins::falseSym;
+                        DISPATCH();
+                    }
+
+                    TARGET(LT_NUM_NUM)
+                    {
+                        double a, b;
+                        if (!peekNumbers(context, a, b)) [[unlikely]]
+                            DEOPTIMIZE(LT);
+                        --context.sp;
+                        context.stack[context.sp - 1] = (a < b) ? Builtins::trueSym : Builtins::falseSym;
+                        DISPATCH();
+                    }
+
+                    TARGET(LE_NUM_NUM)
+                    {
+                        double a, b;
+                        if (!peekNumbers(context, a, b)) [[unlikely]]
+                            DEOPTIMIZE(LE);
+                        --context.sp;
+                        context.stack[context.sp - 1] = (a < b || a == b) ? Builtins::trueSym : Builtins::falseSym;
+                        DISPATCH();
+                    }
+
+                    TARGET(GE_NUM_NUM)
+                    {
+                        double a, b;
+                        if (!peekNumbers(context, a, b)) [[unlikely]]
+                            DEOPTIMIZE(GE);
+                        --context.sp;
+                        context.stack[context.sp - 1] = !(a < b) ? Builtins::trueSym : Builtins::falseSym;
+                        DISPATCH();
+                    }
 #pragma endregion
+#endif
                 }
 #if ARK_USE_COMPUTED_GOTOS
             dispatch_end:
@@ -1284,13 +1898,47 @@ namespace Ark
         throw std::runtime_error(std::string(errorKinds[static_cast<std::size_t>(kind)]) + ": " + message + "\n");
     }
 
+    void VM::throwArityError(const uint16_t needed_argc, const uint16_t argc, ExecutionContext& context)
+    {
+        if (context.last_symbol < m_state.m_symbols.size())
+            throwVMError(
+                ErrorKind::Arity,
+                fmt::format(
+                    "Function `{}' needs {} arguments, but it received {}",
+                    m_state.m_symbols[context.last_symbol], needed_argc, argc));
+        else
+            throwVMError(
+                ErrorKind::Arity,
+                fmt::format(
+                    "Function at page {} needs {} arguments, but it received {}",
+                    context.pp, needed_argc, argc));
+    }
+
+    void VM::throwNotAClosureError(const Value& value, const uint16_t field, ExecutionContext& context)
+    {
+        if (context.last_symbol < m_state.m_symbols.size()) [[likely]]
+            throwVMError(
+                ErrorKind::Type,
+                fmt::format(
+                    "`{}' is a {}, not a Closure, can not get the field `{}' from it",
+                    m_state.m_symbols[context.last_symbol],
+                    types_to_str[static_cast<std::size_t>(value.valueType())],
+                    m_state.m_symbols[field]));
+        else
+            throwVMError(ErrorKind::Type,
+                         fmt::format(
+                             "{} is not a Closure, can not get the field `{}' from it",
+                             types_to_str[static_cast<std::size_t>(value.valueType())],
+                             m_state.m_symbols[field]));
+    }
+
     void VM::backtrace(ExecutionContext& context) noexcept
     {
         const std::size_t saved_ip = context.ip;
         const std::size_t saved_pp = context.pp;
-        const uint16_t saved_sp = context.sp;
+        const std::size_t saved_sp = context.sp;
 
-        if (const uint16_t original_frame_count = context.fc; original_frame_count > 1)
+        if (const std::size_t original_frame_count = context.fc; original_frame_count > 1)
         {
             // display call stack trace
             const Scope old_scope = context.locals.back();
@@ -1353,7 +2001,7 @@ namespace Ark
             pop(context);
         }
 
-        std::cerr << "At IP: " << (saved_ip / 4)  // dividing by 4 because the instructions are actually on 4 bytes
+        std::cerr << "At IP: " << saved_ip
                   << ", PP: " << saved_pp
                   << ", SP: " << saved_sp
                   << "\n";
@@ -6,57 +6,134 @@
 namespace Ark
 {
     Value::Value() noexcept :
-        m_type(ValueType::Undefined)
+        m_type(ValueType::Undefined), m_payload { .number = 0.0 }
     {}
 
     Value::Value(ValueType type) noexcept :
-        m_type(type)
+        m_type(type), m_payload { .number = 0.0 }
     {
         if (type == ValueType::List)
-            m_value = std::vector<Value>();
+            m_payload.list = new internal::HeapCell<std::vector<Value>>();
         else if (type == ValueType::String)
-            m_value = "";
+            m_payload.string = new internal::StringCell(std::string());
     }
 
     Value::Value(const int value) noexcept :
-        m_type(ValueType::Number), m_value(static_cast<double>(value))
+        m_type(ValueType::Number), m_payload { .number = static_cast<double>(value) }
     {}
 
     Value::Value(double value) noexcept :
-        m_type(ValueType::Number), m_value(value)
+        m_type(ValueType::Number), m_payload { .number = value }
     {}
 
     Value::Value(const std::string& value) noexcept :
-        m_type(ValueType::String), m_value(value)
+        m_type(ValueType::String), m_payload { .string = new internal::StringCell(value) }
     {}
 
-    Value::Value(internal::PageAddr_t value) noexcept :
-        m_type(ValueType::PageAddr), m_value(value)
+    Value::Value(std::string&& value) noexcept :
+        m_type(ValueType::String), m_payload { .string = new internal::StringCell(std::move(value)) }
     {}
 
+    Value::Value(internal::PageAddr_t value) noexcept :
+        m_type(ValueType::PageAddr), m_payload { .number = 0.0 }
+    {
+        m_payload.page_addr = value;
+    }
+
     Value::Value(Value::ProcType value) noexcept :
-        m_type(ValueType::CProc), m_value(value)
+        m_type(ValueType::CProc), m_payload { .proc = value }
     {}
 
     Value::Value(std::vector<Value>&& value) noexcept :
-        m_type(ValueType::List), m_value(std::move(value))
+        m_type(ValueType::List), m_payload { .list = new internal::HeapCell<std::vector<Value>>(std::move(value)) }
     {}
 
     Value::Value(internal::Closure&& value) noexcept :
-        m_type(ValueType::Closure), m_value(std::move(value))
+        m_type(ValueType::Closure), m_payload { .closure = new internal::HeapCell<internal::Closure>(std::move(value)) }
     {}
 
     Value::Value(UserType&& value) noexcept :
-        m_type(ValueType::User), m_value(value)
+        m_type(ValueType::User), m_payload { .user = new internal::HeapCell<UserType>(value) }
     {}
 
     Value::Value(Value* ref) noexcept :
-        m_type(ValueType::Reference), m_value(ref)
+        m_type(ValueType::Reference), m_payload { .reference = ref }
     {}
 
+    void Value::copyHeapObject(const Value& other) noexcept
+    {
+        switch (other.m_type)
+        {
+            case ValueType::List:
+                m_payload.list->refcount.fetch_add(1, std::memory_order_relaxed);
+                break;
+
+            case ValueType::String:
+                m_payload.string->refcount.fetch_add(1, std::memory_order_relaxed);
+                break;
+
+            case ValueType::Closure:
+                m_payload.closure->refcount.fetch_add(1, std::memory_order_relaxed);
+                break;
+
+            case ValueType::User:
+                m_payload.user->refcount.fetch_add(1, std::memory_order_relaxed);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void Value::releaseHeapObject() noexcept
+    {
+        switch (m_type)
+        {
+            case ValueType::List:
+                if (m_payload.list->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete m_payload.list;
+                break;
+
+            case ValueType::String:
+                if (m_payload.string->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete m_payload.string;
+                break;
+
+            case ValueType::Closure:
+                if (m_payload.closure->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete m_payload.closure;
+                break;
+
+            case ValueType::User:
+                if (m_payload.user->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete m_payload.user;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void Value::detachList()
+    {
+        auto* copy = new internal::HeapCell<std::vector<Value>>(m_payload.list->object);
+        releaseHeapObject();
+        m_payload.list = copy;
+    }
+
+    void Value::detachString()
+    {
+        auto* copy = new internal::StringCell(m_payload.string->object);
+        releaseHeapObject();
+        m_payload.string = copy;
+    }
+
     void Value::push_back(const Value& value)
     {
-        list().emplace_back(value);
+        // copy the value before getting the list: if it is the list itself, the copy
+        // shares it and forces us to work on a new list instead of creating a cycle
+        Value copy(value);
+        list().emplace_back(std::move(copy));
     }
 
     void Value::push_back(Value&& value)
@@ -75,14 +75,18 @@ namespace Ark
                         m_has_init_vm = true;
                     }
                     else
+                    {
                         std::ignore = m_vm.forceReloadPlugins();
+                        // the code was compiled again, the VM has to thread it and to build its inline caches again
+                        m_vm.prepareCode();
+                    }
 
                     if (m_vm.safeRun(*m_vm.m_execution_contexts[0]) == 0)
                     {
                         // save good code
                         m_code = new_code;
                         // place ip to end of bytecode instruction (HALT)
-                        m_vm.m_execution_contexts[0]->ip -= 4;
+                        m_vm.m_execution_contexts[0]->ip -= 1;
                     }
                     else
                     {
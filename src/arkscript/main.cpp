@@ -46,6 +46,8 @@ int main(int argc, char** argv)
     // Eval / Run / AST dump
     std::string file, eval_expression;
     std::string libdir;
+    // Run
+    bool jit = false;
     // Formatting
     bool format_dry_run = false;
     bool format_check = false;
@@ -104,6 +106,7 @@ int main(int argc, char** argv)
                   debug_flag
                 , lib_dir_flag
                 , compiler_passes_flag
+                , option("--jit").set(jit, true).doc("Compile the hot loops to native code (x86-64 Linux, if ArkScript was built with ARK_ENABLE_JIT)")
             )
             , any_other(script_args)
         )
@@ -201,7 +204,7 @@ int main(int argc, char** argv)
                 fmt::println(
                     "Have been compiled with {}\n\n"
                     "sizeof(Ark::Value)    = {}B\n"
-                    "      sizeof(Value_t) = {}B\n"
+                    "      sizeof(Payload)   = {}B\n"
                     "      sizeof(ValueType) = {}B\n"
                     "      sizeof(ProcType)  = {}B\n"
                     "      sizeof(Ark::Closure)  = {}B\n"
@@ -218,7 +221,7 @@ int main(int argc, char** argv)
                     ARK_COMPILER,
                     // value
                     sizeof(Ark::Value),
-                    sizeof(Ark::Value::Value_t),
+                    sizeof(Ark::Value::Payload),
                     sizeof(Ark::ValueType),
                     sizeof(Ark::Value::ProcType),
                     sizeof(Ark::internal::Closure),
@@ -262,6 +265,8 @@ int main(int argc, char** argv)
                     return -1;
 
                 Ark::VM vm(state);
+                if (jit && !vm.enableJit())
+                    fmt::println("{}:  The JIT isn't available in this build, running the interpreter", fmt::styled("Warning", fmt::fg(fmt::color::dark_orange)));
                 return vm.run();
             }
 
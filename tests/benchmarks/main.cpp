@@ -78,6 +78,20 @@ void builtins(benchmark::State& s)
 }
 BENCHMARK(builtins)->Unit(benchmark::kMillisecond);
 
+// cppcheck-suppress constParameterCallback
+void dispatch(benchmark::State& s)
+{
+    Ark::State state;
+    state.doFile(std::string(ARK_TESTS_ROOT) + "tests/benchmarks/resources/runtime/dispatch.ark");
+
+    for (auto _ : s)
+    {
+        Ark::VM vm(state);
+        benchmark::DoNotOptimize(vm.run());
+    }
+}
+BENCHMARK(dispatch)->Unit(benchmark::kMillisecond);
+
 // --------------------------------------------
 // parser benchmarks
 // --------------------------------------------
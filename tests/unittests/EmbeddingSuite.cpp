@@ -118,6 +118,31 @@ ut::suite<"Embedding"> embedding_suite = [] {
         };
     };
 
+    "[configure the size of the VM stack]"_test = [] {
+        constexpr auto code = "(let sum (fun (n) (if (= 0 n) 0 (+ n (sum (- n 1))))))";
+
+        should("grow the stack as needed") = [&] {
+            Ark::State state;
+            state.setStackSize(/* initial_size= */ 4, /* max_size= */ 64);
+            expect(state.doString(std::string(code) + "(let a (sum 10))"));
+
+            Ark::VM vm(state);
+            expect(vm.run() == 0_i);
+            const auto a = vm["a"];
+            expect(a.valueType() == Ark::ValueType::Number);
+            expect(a.number() == 55_i);
+        };
+
+        should("stop deep recursions when reaching the maximum stack size") = [&] {
+            Ark::State state;
+            state.setStackSize(/* initial_size= */ 4, /* max_size= */ 64);
+            expect(state.doString(std::string(code) + "(let a (sum 100))"));
+
+            Ark::VM vm(state);
+            expect(throws([&] { vm.run(/* fail_with_exception= */ true); }));
+        };
+    };
+
     "[load cpp function and call it from arkscript]"_test = [] {
         Ark::State state;
         state.loadFunction("my_function", my_function);
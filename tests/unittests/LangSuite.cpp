@@ -22,4 +22,23 @@ ut::suite<"Lang"> lang_suite = [] {
             expect(mut(vm).run() == 0_i);
         };
     };
+
+#ifndef ARK_ENABLE_JIT
+    // the JIT is only built with ARK_ENABLE_JIT, on x86-64 Linux
+    skip /
+#endif
+    "[run arkscript unittests with the JIT]"_test = [] {
+        Ark::State state({ std::filesystem::path(ARK_TESTS_ROOT "/lib/") });
+
+        should("compile the resource without any error") = [&] {
+            expect(mut(state).doFile(get_resource_path("LangSuite/unittests.ark")));
+        };
+
+        Ark::VM vm(state);
+        // the loops of the resources have to run in native code, not in the interpreter
+        expect(fatal(mut(vm).enableJit()));
+        should("return exit code 0") = [&] {
+            expect(mut(vm).run() == 0_i);
+        };
+    };
 };